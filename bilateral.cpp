@@ -0,0 +1,163 @@
+/**
+ * @file   bilateral.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Edge preserving bilateral filter using a bilateral grid
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "bilateral.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+constexpr std::int32_t grid_padding = 1;
+
+auto guide_at(float const* pixel, std::int32_t const& channels) -> float {
+    if (channels < 3) return std::clamp(pixel[0], 0.0f, 1.0f);
+    return std::clamp(0.2126f * pixel[0] + 0.7152f * pixel[1] + 0.0722f * pixel[2], 0.0f, 1.0f);
+}
+
+struct grid {
+    std::int32_t width;
+    std::int32_t height;
+    std::int32_t depth;
+    std::int32_t cell;  // channels + homogeneous weight
+    std::vector<float> data;
+
+    auto at(std::int32_t const& x, std::int32_t const& y, std::int32_t const& z) -> float* {
+        return data.data() + ((static_cast<std::ptrdiff_t>(y) * width + x) * depth + z) * cell;
+    }
+    auto row_size() const -> std::int32_t { return width * depth * cell; }
+};
+
+/**
+ * [1 2 1] / 4 along one grid axis, cells outside the grid count as empty.
+ * @param stride Distance between neighbouring cells along the axis in floats.
+ * @param count  Number of cells along the axis.
+ */
+auto blur_line(float const* in, float* out, std::int32_t const& stride, std::int32_t const& count, std::int32_t const& cell) -> void {
+    for (std::int32_t i = 0; i < count; ++i) {
+        auto const* c = in + i * stride;
+        auto* o = out + i * stride;
+        for (std::int32_t k = 0; k < cell; ++k) {
+            auto value = 2.0f * c[k];
+            if (i > 0)         value += c[k - stride];
+            if (i < count - 1) value += c[k + stride];
+            o[k] = value * 0.25f;
+        }
+    }
+}
+}
+
+auto bilateral_filter(image const& source, image& destination, float const& sigma_spatial, float const& sigma_range) -> void {
+    if (sigma_spatial <= 0.0f || sigma_range <= 0.0f)
+        throw std::invalid_argument("nrv::bilateral_filter: sigmas must be positive");
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::bilateral_filter: source and destination dimensions differ");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+    auto const inv_s    = 1.0f / sigma_spatial;
+    auto const inv_r    = 1.0f / sigma_range;
+
+    grid g{};
+    g.width  = static_cast<std::int32_t>(static_cast<float>(width  - 1) * inv_s) + 1 + 2 * grid_padding;
+    g.height = static_cast<std::int32_t>(static_cast<float>(height - 1) * inv_s) + 1 + 2 * grid_padding;
+    g.depth  = static_cast<std::int32_t>(inv_r) + 1 + 2 * grid_padding;
+    g.cell   = channels + 1;
+    g.data.assign(static_cast<std::size_t>(g.row_size()) * static_cast<std::size_t>(g.height), 0.0f);
+    auto tmp = g;
+
+    auto const row_floats = width * channels;
+    auto const row_of = [&](std::int32_t const& y) {
+        return source.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(row_floats);
+    };
+
+    // Splat, every grid row only receives the image rows rounding to it so grid rows can be filled in parallel.
+    std::vector<std::int32_t> first_row(static_cast<std::size_t>(g.height + 1), height);
+    for (auto y = height - 1; y >= 0; --y) {
+        auto const gy = static_cast<std::int32_t>(static_cast<float>(y) * inv_s + 0.5f) + grid_padding;
+        first_row[static_cast<std::size_t>(gy)] = y;
+    }
+    for (auto gy = g.height - 1; gy >= 0; --gy)
+        first_row[static_cast<std::size_t>(gy)] = std::min(first_row[static_cast<std::size_t>(gy)], first_row[static_cast<std::size_t>(gy + 1)]);
+
+    parallel_for(g.height, [&](std::int32_t const& gy) {
+        auto const begin = first_row[static_cast<std::size_t>(gy)];
+        auto const end   = first_row[static_cast<std::size_t>(gy + 1)];
+        for (auto y = begin; y < end; ++y) {
+            auto const* row = row_of(y);
+            for (std::int32_t x = 0; x < width; ++x) {
+                auto const* pixel = row + x * channels;
+                auto const gx = static_cast<std::int32_t>(static_cast<float>(x) * inv_s + 0.5f) + grid_padding;
+                auto const gz = static_cast<std::int32_t>(guide_at(pixel, channels) * inv_r + 0.5f) + grid_padding;
+                auto* cell = g.at(gx, gy, gz);
+                for (std::int32_t c = 0; c < channels; ++c) cell[c] += pixel[c];
+                cell[channels] += 1.0f;
+            }
+        }
+    });
+
+    // Blur along range and x within every grid row, then along y across rows.
+    parallel_for(g.height, [&](std::int32_t const& gy) {
+        for (std::int32_t gx = 0; gx < g.width; ++gx)
+            blur_line(g.at(gx, gy, 0), tmp.at(gx, gy, 0), g.cell, g.depth, g.cell);
+        for (std::int32_t gz = 0; gz < g.depth; ++gz)
+            blur_line(tmp.at(0, gy, gz), g.at(0, gy, gz), g.depth * g.cell, g.width, g.cell);
+    });
+    parallel_for(g.width, [&](std::int32_t const& gx) {
+        for (std::int32_t gz = 0; gz < g.depth; ++gz)
+            blur_line(g.at(gx, 0, gz), tmp.at(gx, 0, gz), g.row_size(), g.height, g.cell);
+    });
+
+    // Slice with trilinear interpolation and divide by the accumulated weight.
+    parallel_for_range(height, 8, [&](std::int32_t const& begin, std::int32_t const& end) {
+        std::vector<float> value(static_cast<std::size_t>(g.cell));
+        for (auto y = begin; y < end; ++y) {
+            auto const* row = row_of(y);
+            auto* out = destination.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(row_floats);
+            auto const fy = static_cast<float>(y) * inv_s + grid_padding;
+            auto const y0 = std::min(static_cast<std::int32_t>(fy), g.height - 2);
+            auto const ty = fy - static_cast<float>(y0);
+            for (std::int32_t x = 0; x < width; ++x) {
+                auto const* pixel = row + x * channels;
+                auto const fx = static_cast<float>(x) * inv_s + grid_padding;
+                auto const fz = guide_at(pixel, channels) * inv_r + grid_padding;
+                auto const x0 = std::min(static_cast<std::int32_t>(fx), g.width - 2);
+                auto const z0 = std::min(static_cast<std::int32_t>(fz), g.depth - 2);
+                auto const tx = fx - static_cast<float>(x0);
+                auto const tz = fz - static_cast<float>(z0);
+
+                std::fill(value.begin(), value.end(), 0.0f);
+                for (std::int32_t k = 0; k < 8; ++k) {
+                    auto const dx = k & 1;
+                    auto const dy = (k >> 1) & 1;
+                    auto const dz = (k >> 2) & 1;
+                    auto const weight = (dx ? tx : 1.0f - tx) * (dy ? ty : 1.0f - ty) * (dz ? tz : 1.0f - tz);
+                    auto const* cell = tmp.at(x0 + dx, y0 + dy, z0 + dz);
+                    for (std::int32_t c = 0; c < g.cell; ++c) value.data()[c] += weight * cell[c];
+                }
+
+                auto const total = value.data()[channels];
+                for (std::int32_t c = 0; c < channels; ++c)
+                    out[x * channels + c] = total > 1e-6f ? value.data()[c] / total : pixel[c];
+            }
+        }
+    });
+}
+
+auto bilateral_filter(image const& source, float const& sigma_spatial, float const& sigma_range) -> image {
+    image output{source.width(), source.height(), source.channels()};
+    bilateral_filter(source, output, sigma_spatial, sigma_range);
+    return output;
+}
+}
@@ -0,0 +1,29 @@
+/**
+ * @file   bilateral.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Edge preserving bilateral filter using a bilateral grid
+ *         https://people.csail.mit.edu/sparis/publi/2009/fntcgv/Paris_09_Bilateral_filtering.pdf
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_BILATERAL_HPP
+#define IMAGEPP_BILATERAL_HPP
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Approximate bilateral filter. Pixels are splatted into a coarse (x, y, luminance) grid with cells of
+ * sigma_spatial pixels and sigma_range intensity, the grid is blurred and then sliced with trilinear
+ * interpolation. Cost is linear in the pixel count whatever the spatial sigma.
+ * @param source        Image to filter, values in [0, 1].
+ * @param destination   Filtered output, same dimensions as source.
+ * @param sigma_spatial Spatial extent in pixels.
+ * @param sigma_range   Intensity extent, edges with a larger step are preserved.
+ */
+auto bilateral_filter(image const& source, image& destination, float const& sigma_spatial, float const& sigma_range) -> void;
+auto bilateral_filter(image const& source, float const& sigma_spatial, float const& sigma_range) -> image;
+}
+
+#endif  // IMAGEPP_BILATERAL_HPP
@@ -0,0 +1,56 @@
+/**
+ * @file   bitmap.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Packed 1-bit image
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "bitmap.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+namespace nrv {
+bitmap::bitmap(std::int32_t const& width, std::int32_t const& height)
+    : m_width(width), m_height(height), m_stride((width + 63) / 64)
+    , m_buffer(static_cast<std::size_t>(m_stride * m_height), 0) {}
+
+bitmap::bitmap(image const& source, float const& threshold) : bitmap(source.width(), source.height()) {
+    auto const channels = source.channels();
+    parallel_for_range(m_height, 32, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const* in = source.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width * channels);
+            auto* out = row(y);
+            for (std::int32_t w = 0; w < m_stride; ++w) {
+                auto const count = std::min(64, m_width - w * 64);
+                std::uint64_t word = 0;
+                for (std::int32_t b = 0; b < count; ++b)
+                    word |= std::uint64_t{in[(w * 64 + b) * channels] >= threshold} << b;
+                out[w] = word;
+            }
+        }
+    });
+}
+
+auto bitmap::unpack(image& destination) const -> void {
+    if (destination.width() != m_width || destination.height() != m_height)
+        throw std::invalid_argument("nrv::bitmap::unpack: destination dimensions differ");
+    auto const channels = destination.channels();
+    auto const colour   = colour_channels(channels);
+    parallel_for_range(m_height, 32, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const* in = row(y);
+            auto* out = destination.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width * channels);
+            for (std::int32_t x = 0; x < m_width; ++x) {
+                auto const value = static_cast<float>((in[x / 64] >> (x % 64)) & 1);
+                auto* pixel = out + x * channels;
+                for (std::int32_t c = 0; c < colour; ++c) pixel[c] = value;
+                for (auto c = colour; c < channels; ++c) pixel[c] = 1.0f;
+            }
+        }
+    });
+}
+}
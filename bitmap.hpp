@@ -0,0 +1,70 @@
+/**
+ * @file   bitmap.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Packed 1-bit image
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_BITMAP_HPP
+#define IMAGEPP_BITMAP_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * 1-bit image with 64 pixels per word. Pixel x of a row is bit x % 64 of word x / 64,
+ * bits past the width in the last word of a row are always zero.
+ */
+class bitmap {
+  public:
+    bitmap(std::int32_t const& width, std::int32_t const& height);
+    /**
+     * Threshold the first channel of an image, pixels at or above the threshold are set.
+     */
+    bitmap(image const& source, float const& threshold = 0.5f);
+
+    auto width()  const -> std::int32_t { return m_width; }
+    auto height() const -> std::int32_t { return m_height; }
+    auto stride() const -> std::int32_t { return m_stride; }  // words per row
+    auto buffer() -> std::uint64_t* { return m_buffer.data(); }
+    auto buffer() const -> std::uint64_t const* { return m_buffer.data(); }
+    auto row(std::int32_t const& y) -> std::uint64_t* { return m_buffer.data() + y * m_stride; }
+    auto row(std::int32_t const& y) const -> std::uint64_t const* { return m_buffer.data() + y * m_stride; }
+
+    auto get(std::int32_t const& x, std::int32_t const& y) const -> bool {
+        if (x < 0 || x > m_width - 1 || y < 0 || y > m_height - 1) return false;
+        return (row(y)[x / 64] >> (x % 64)) & 1;
+    }
+    auto set(std::int32_t const& x, std::int32_t const& y, bool const& value) -> void {
+        if (x < 0 || x > m_width - 1 || y < 0 || y > m_height - 1) return;
+        auto const mask = std::uint64_t{1} << (x % 64);
+        if (value) row(y)[x / 64] |= mask;
+        else       row(y)[x / 64] &= ~mask;
+    }
+
+    /**
+     * Mask of the valid bits in the last word of a row.
+     */
+    auto tail_mask() const -> std::uint64_t {
+        auto const bits = m_width % 64;
+        return bits == 0 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+    }
+
+    /**
+     * Expand to 0.0 and 1.0 in the colour channels of the destination, alpha is set opaque.
+     */
+    auto unpack(image& destination) const -> void;
+
+  private:
+    std::int32_t               m_width;
+    std::int32_t               m_height;
+    std::int32_t               m_stride;
+    std::vector<std::uint64_t> m_buffer;
+};
+}
+
+#endif  // IMAGEPP_BITMAP_HPP
@@ -0,0 +1,203 @@
+/**
+ * @file   blur.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Blur filters
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "blur.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "parallel.hpp"
+#include "tile.hpp"
+
+namespace nrv {
+namespace {
+/**
+ * Sum of the clamped window [i - radius, i + radius] around i = 0 of a line of count samples, at(k) reads sample k.
+ * Samples past the end repeat the last one, so the cost is min(radius, count) whatever the radius.
+ */
+template <typename at_fn_t>
+auto first_window(std::int32_t const& count, std::int32_t const& radius, at_fn_t const& at) -> double {
+    auto sum = static_cast<double>(radius + std::int64_t{1}) * at(0);
+    auto const inside = std::min(radius, count - 1);
+    for (std::int32_t k = 1; k <= inside; ++k) sum += at(k);
+    return sum + static_cast<double>(radius - inside) * at(count - 1);
+}
+
+/**
+ * Indices entering and leaving the window when it slides from i to i + 1, clamped to the line.
+ */
+auto window_step(std::int32_t const& i, std::int32_t const& count, std::int32_t const& radius) -> std::pair<std::int32_t, std::int32_t> {
+    auto const enter = i < count - 1 - radius ? i + radius + 1 : count - 1;
+    auto const leave = i > radius ? i - radius : 0;
+    return {enter, leave};
+}
+
+/**
+ * Normalised Gaussian weights for offsets [-radius, radius] with radius = ceil(3 * sigma).
+ */
+auto gaussian_weights(float const& sigma) -> std::vector<float> {
+    auto const radius = static_cast<std::int32_t>(std::ceil(3.0f * sigma));
+    std::vector<float> weights(static_cast<std::size_t>(2 * radius + 1));
+    auto total = 0.0f;
+    for (auto i = -radius; i <= radius; ++i) {
+        auto const x = static_cast<float>(i);
+        auto& w = weights[static_cast<std::size_t>(i + radius)];
+        w = std::exp(-(x * x) / (2.0f * sigma * sigma));
+        total += w;
+    }
+    for (auto& w : weights) w /= total;
+    return weights;
+}
+
+/**
+ * Separable convolution of one tile, the tile halo must be at least weights.size() / 2.
+ */
+auto convolve_tile(tile const& t, std::vector<float> const& weights, float* out, std::int32_t const& stride) -> void {
+    thread_local std::vector<float> rows{};
+
+    auto const radius    = static_cast<std::int32_t>(weights.size() / 2);
+    auto const window    = static_cast<std::int32_t>(weights.size());
+    auto const row_size  = t.width * t.channels;
+    auto const in_height = t.height + 2 * radius;
+    rows.assign(static_cast<std::size_t>(row_size * in_height), 0.0f);
+
+    // Taps in the outer loop so the inner loop runs contiguously over the row.
+    for (std::int32_t i = 0; i < in_height; ++i) {
+        auto const* in = t.in(-radius, i - radius);
+        auto* row = rows.data() + i * row_size;
+        for (std::int32_t k = 0; k < window; ++k) {
+            auto const w = weights.data()[k];
+            auto const* src = in + k * t.channels;
+            for (std::int32_t j = 0; j < row_size; ++j) row[j] += w * src[j];
+        }
+    }
+    for (std::int32_t i = 0; i < t.height; ++i) {
+        auto* o = out + i * stride;
+        std::fill_n(o, row_size, 0.0f);
+        for (std::int32_t k = 0; k < window; ++k) {
+            auto const w = weights.data()[k];
+            auto const* src = rows.data() + (i + k) * row_size;
+            for (std::int32_t j = 0; j < row_size; ++j) o[j] += w * src[j];
+        }
+    }
+}
+}
+
+auto box_blur(image const& source, image& destination, std::int32_t const& radius) -> void {
+    if (radius < 0) throw std::invalid_argument("nrv::box_blur: radius must not be negative");
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::box_blur: source and destination dimensions differ");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+    auto const stride   = static_cast<std::size_t>(width) * static_cast<std::size_t>(channels);
+    if (width == 0 || height == 0) return;
+
+    // Separable sliding windows over whole rows and then whole columns, no halo is gathered so the cost per
+    // pixel does not depend on the radius. Sums are kept in double, a window slides across the full image.
+    image rows{width, height, channels};
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        std::vector<double> sums(static_cast<std::size_t>(channels));
+        for (auto y = begin; y < end; ++y) {
+            auto const* in = source.buffer() + static_cast<std::size_t>(y) * stride;
+            auto* out = rows.buffer() + static_cast<std::size_t>(y) * stride;
+            for (std::int32_t c = 0; c < channels; ++c)
+                sums[static_cast<std::size_t>(c)] = first_window(width, radius, [&](std::int32_t const& x) { return static_cast<double>(in[x * channels + c]); });
+            for (std::int32_t x = 0; x < width; ++x) {
+                auto const [enter, leave] = window_step(x, width, radius);
+                auto const* add = in + enter * channels;
+                auto const* sub = in + leave * channels;
+                for (std::int32_t c = 0; c < channels; ++c) {
+                    auto& sum = sums[static_cast<std::size_t>(c)];
+                    out[x * channels + c] = static_cast<float>(sum);
+                    sum += static_cast<double>(add[c] - sub[c]);
+                }
+            }
+        }
+    });
+
+    // Columns in strips, each strip slides down the image with whole row segments so the inner loops are contiguous.
+    constexpr std::size_t strip = 512;
+    auto const strips = static_cast<std::int32_t>((stride + strip - 1) / strip);
+    auto const window = 2.0 * radius + 1.0;
+    auto const scale  = 1.0 / (window * window);
+    parallel_for(strips, [&](std::int32_t const& index) {
+        thread_local std::vector<double> sums{};
+        auto const first = static_cast<std::size_t>(index) * strip;
+        auto const count = std::min(strip, stride - first);
+        auto const row = [&](std::int32_t const& y) { return rows.buffer() + static_cast<std::size_t>(y) * stride + first; };
+        sums.resize(count);
+        for (std::size_t j = 0; j < count; ++j)
+            sums[j] = first_window(height, radius, [&](std::int32_t const& y) { return static_cast<double>(row(y)[j]); });
+        for (std::int32_t y = 0; y < height; ++y) {
+            auto* out = destination.buffer() + static_cast<std::size_t>(y) * stride + first;
+            for (std::size_t j = 0; j < count; ++j) out[j] = static_cast<float>(sums[j] * scale);
+            auto const [enter, leave] = window_step(y, height, radius);
+            auto const* add = row(enter);
+            auto const* sub = row(leave);
+            for (std::size_t j = 0; j < count; ++j) sums[j] += static_cast<double>(add[j] - sub[j]);
+        }
+    });
+}
+
+auto box_blur(image const& source, std::int32_t const& radius) -> image {
+    image output{source.width(), source.height(), source.channels()};
+    box_blur(source, output, radius);
+    return output;
+}
+
+auto gaussian_blur(image const& source, image& destination, float const& sigma) -> void {
+    if (!(sigma > 0.0f)) throw std::invalid_argument("nrv::gaussian_blur: sigma must be positive");
+    auto const weights = gaussian_weights(sigma);
+    for_each_tile(source, destination, static_cast<std::int32_t>(weights.size() / 2), [&](tile const& t) {
+        convolve_tile(t, weights, t.output, t.output_stride);
+    });
+}
+
+auto gaussian_blur(image const& source, float const& sigma) -> image {
+    image output{source.width(), source.height(), source.channels()};
+    gaussian_blur(source, output, sigma);
+    return output;
+}
+
+auto unsharp_mask(image const& source, image& destination, float const& amount, float const& radius, float const& threshold) -> void {
+    if (!(radius > 0.0f)) throw std::invalid_argument("nrv::unsharp_mask: radius must be positive");
+    auto const weights = gaussian_weights(radius);
+
+    // Blur and combine per tile, the blurred image never exists in full.
+    for_each_tile(source, destination, static_cast<std::int32_t>(weights.size() / 2), [&](tile const& t) {
+        thread_local std::vector<float> blurred{};
+        auto const row_size = t.width * t.channels;
+        blurred.resize(static_cast<std::size_t>(row_size * t.height));
+        convolve_tile(t, weights, blurred.data(), row_size);
+
+        auto const colour = colour_channels(t.channels);
+        for (std::int32_t i = 0; i < t.height; ++i) {
+            auto const* in = t.in(0, i);
+            auto const* bl = blurred.data() + i * row_size;
+            auto* out = t.out(0, i);
+            for (std::int32_t j = 0; j < row_size; ++j) {
+                auto const detail = in[j] - bl[j];
+                auto const keep   = std::abs(detail) < threshold || j % t.channels >= colour;
+                out[j] = keep ? in[j] : std::clamp(in[j] + amount * detail, 0.0f, 1.0f);
+            }
+        }
+    });
+}
+
+auto unsharp_mask(image const& source, float const& amount, float const& radius, float const& threshold) -> image {
+    image output{source.width(), source.height(), source.channels()};
+    unsharp_mask(source, output, amount, radius, threshold);
+    return output;
+}
+}
@@ -0,0 +1,51 @@
+/**
+ * @file   blur.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Blur filters
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_BLUR_HPP
+#define IMAGEPP_BLUR_HPP
+
+#include <cstdint>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Box blur with a (2 * radius + 1)^2 window, edges are clamped. Runs as a sliding window over whole
+ * rows and then whole columns, so the cost per pixel does not depend on the radius.
+ * https://en.wikipedia.org/wiki/Box_blur
+ * @param source      Image to blur.
+ * @param destination Blurred output, same dimensions as source, may be source itself.
+ * @param radius      Window radius in pixels.
+ */
+auto box_blur(image const& source, image& destination, std::int32_t const& radius = 1) -> void;
+auto box_blur(image const& source, std::int32_t const& radius = 1) -> image;
+
+/**
+ * Separable Gaussian blur with a kernel radius of ceil(3 * sigma), edges are clamped.
+ * @param source      Image to blur.
+ * @param destination Blurred output, same dimensions as source.
+ * @param sigma       Standard deviation in pixels.
+ */
+auto gaussian_blur(image const& source, image& destination, float const& sigma) -> void;
+auto gaussian_blur(image const& source, float const& sigma) -> image;
+
+/**
+ * Unsharp mask, source + amount * (source - gaussian_blur(source)) clamped to [0, 1].
+ * The blur and the combine run on the same tile, so the blurred image is never written out.
+ * Alpha is left untouched.
+ * @param source      Image to sharpen.
+ * @param destination Sharpened output, same dimensions as source.
+ * @param amount      Strength of the sharpening, 0 leaves the image unchanged.
+ * @param radius      Gaussian sigma of the blur in pixels.
+ * @param threshold   Differences smaller than this are left alone so flat areas and noise are not sharpened.
+ */
+auto unsharp_mask(image const& source, image& destination, float const& amount, float const& radius, float const& threshold = 0.0f) -> void;
+auto unsharp_mask(image const& source, float const& amount, float const& radius, float const& threshold = 0.0f) -> image;
+}
+
+#endif  // IMAGEPP_BLUR_HPP
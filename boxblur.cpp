@@ -11,36 +11,18 @@
 #include <filesystem>
 #include <cmath>
 #include <iostream>
+#include <string>
+#include <algorithm>
 
 #include "image.hpp"
-
-auto box_blur(nrv::image const& img) -> nrv::image {
-    nrv::image output{img.width(), img.height(), img.channels()};
-    nrv::render_img(img, [&](glm::ivec2 const& pos, glm::vec4 const&) {
-        auto sum_at = [&](glm::ivec2 const& offset) {
-            return img.get_pixel_rgba(pos.x + offset.x, pos.y + offset.y);
-        };
-
-        std::int32_t const blur_width  = 1;
-        std::int32_t const blur_height = 1;
-        auto sum = glm::vec4{0.0f};
-        auto denom = 0.0f;
-        for (std::int32_t i = -blur_height; i <= blur_height; ++i) {
-            for (std::int32_t j = -blur_width; j <= blur_width; ++j) {
-                sum += sum_at({j, i});
-                denom += 1.0f;
-            }
-        }
-
-        output.set_pixel(pos.x, pos.y, sum / denom);
-    });
-    return output;
-}
+#include "blur.hpp"
+#include "qoi.hpp"
 
 auto main([[maybe_unused]]int argc, [[maybe_unused]]char const* argv[]) -> int {
     if (argc < 2) {
         std::cout << "No file given\n";
-        std::cout << "usage: " << argv[0] << " {filename}\n";
+        std::cout << "usage: " << argv[0] << " {filename} [radius] [format]\n";
+        std::cout << "    [format] - png (default) or qoi\n";
         return 1;
     }
 
@@ -50,9 +32,19 @@ auto main([[maybe_unused]]int argc, [[maybe_unused]]char const* argv[]) -> int {
         return 1;
     }
 
+    std::int32_t radius = 1;
+    if (argc > 2) radius = std::max(std::stoi(argv[2]), 0);
+
+    std::string const format = argc > 3 ? argv[3] : "png";
+    if (format != "png" && format != "qoi") {
+        std::cout << "format must be png or qoi\n";
+        return 1;
+    }
+
     nrv::image image{filename};
-    auto out = box_blur(image);
-    nrv::write_png("box_blur_out.png", out);
+    auto out = nrv::box_blur(image, radius);
+    if (format == "qoi") nrv::write_qoi("box_blur_out.qoi", out);
+    else                 nrv::write_png("box_blur_out.png", out);
 
     return 0;
 }
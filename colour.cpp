@@ -0,0 +1,89 @@
+/**
+ * @file   colour.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  3x4 colour matrices for greyscale and colour space conversions
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "colour.hpp"
+
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+using row_fn_t = auto (*)(float const*, float*, std::int32_t const&, colour_matrix const&) -> void;
+
+// Channel counts are template arguments so every layout pair compiles to a branch free loop the compiler
+// can unroll and vectorise.
+template <std::int32_t input, std::int32_t output>
+auto transform_row(float const* in, float* out, std::int32_t const& count, colour_matrix const& matrix) -> void {
+    constexpr auto rows  = colour_channels(output) < 3 ? 1 : 3;
+    constexpr auto alpha = output == 2 || output == 4;
+    constexpr auto grey  = input < 3;
+    auto const& m = matrix.rows;
+    auto const m00 = m[0][0], m01 = m[0][1], m02 = m[0][2], m03 = m[0][3];
+    auto const m10 = m[1][0], m11 = m[1][1], m12 = m[1][2], m13 = m[1][3];
+    auto const m20 = m[2][0], m21 = m[2][1], m22 = m[2][2], m23 = m[2][3];
+    for (std::int32_t x = 0; x < count; ++x) {
+        auto const* p = in + x * input;
+        auto* q = out + x * output;
+        auto const r = p[0];
+        auto const g = grey ? p[0] : p[1 % input];
+        auto const b = grey ? p[0] : p[2 % input];
+        q[0] = m00 * r + m01 * g + m02 * b + m03;
+        if constexpr (rows == 3) {
+            q[1] = m10 * r + m11 * g + m12 * b + m13;
+            q[2] = m20 * r + m21 * g + m22 * b + m23;
+        }
+        if constexpr (alpha) {
+            if constexpr (input == 2 || input == 4) q[output - 1] = p[input - 1];
+            else                                    q[output - 1] = 1.0f;
+        }
+    }
+}
+
+template <std::int32_t input>
+constexpr auto row_functions() -> std::array<row_fn_t, 4> {
+    return {transform_row<input, 1>, transform_row<input, 2>, transform_row<input, 3>, transform_row<input, 4>};
+}
+
+constexpr std::array<std::array<row_fn_t, 4>, 4> row_table{
+    row_functions<1>(), row_functions<2>(), row_functions<3>(), row_functions<4>()
+};
+}
+
+auto apply_colour_matrix(image const& source, image& destination, colour_matrix const& matrix) -> void {
+    if (source.width() != destination.width() || source.height() != destination.height())
+        throw std::invalid_argument("nrv::apply_colour_matrix: source and destination dimensions differ");
+    if (source.channels() < 1 || source.channels() > 4 || destination.channels() < 1 || destination.channels() > 4)
+        throw std::invalid_argument("nrv::apply_colour_matrix: only 1 to 4 channels are supported");
+    if (source.buffer() == destination.buffer() && source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::apply_colour_matrix: in place conversion must keep the channel count");
+
+    auto const width  = source.width();
+    auto const input  = source.channels();
+    auto const output = destination.channels();
+    auto const fn = row_table[static_cast<std::size_t>(input - 1)][static_cast<std::size_t>(output - 1)];
+    parallel_for_range(source.height(), 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const row = static_cast<std::size_t>(y) * static_cast<std::size_t>(width);
+            fn(source.buffer() + row * static_cast<std::size_t>(input),
+               destination.buffer() + row * static_cast<std::size_t>(output), width, matrix);
+        }
+    });
+}
+
+auto apply_colour_matrix(image const& source, colour_matrix const& matrix, std::int32_t const& channels) -> image {
+    image destination{source.width(), source.height(), channels};
+    apply_colour_matrix(source, destination, matrix);
+    return destination;
+}
+
+auto greyscale(image const& source) -> image {
+    auto const alpha = source.channels() == 2 || source.channels() == 4;
+    return apply_colour_matrix(source, rec709_luma, alpha ? 2 : 1);
+}
+}
@@ -0,0 +1,92 @@
+/**
+ * @file   colour.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  3x4 colour matrices for greyscale and colour space conversions
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_COLOUR_HPP
+#define IMAGEPP_COLOUR_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Affine colour transform, output channel r is rows[r][0] * R + rows[r][1] * G + rows[r][2] * B + rows[r][3].
+ */
+struct colour_matrix {
+    std::array<std::array<float, 4>, 3> rows;
+};
+
+/**
+ * Luma with Rec.601 weights, every row holds the weights so three channel output stays grey.
+ */
+inline constexpr colour_matrix rec601_luma{{{
+    {0.299f, 0.587f, 0.114f, 0.0f},
+    {0.299f, 0.587f, 0.114f, 0.0f},
+    {0.299f, 0.587f, 0.114f, 0.0f},
+}}};
+
+/**
+ * Luminance with Rec.709 weights.
+ */
+inline constexpr colour_matrix rec709_luma{{{
+    {0.2126f, 0.7152f, 0.0722f, 0.0f},
+    {0.2126f, 0.7152f, 0.0722f, 0.0f},
+    {0.2126f, 0.7152f, 0.0722f, 0.0f},
+}}};
+
+/**
+ * Full range BT.601 YCbCr as used by JPEG, chroma is centred on 0.5.
+ */
+inline constexpr colour_matrix rgb_to_ycbcr{{{
+    { 0.299f,     0.587f,     0.114f,    0.0f},
+    {-0.168736f, -0.331264f,  0.5f,      0.5f},
+    { 0.5f,      -0.418688f, -0.081312f, 0.5f},
+}}};
+
+inline constexpr colour_matrix ycbcr_to_rgb{{{
+    {1.0f,  0.0f,       1.402f,    -0.701f},
+    {1.0f, -0.344136f, -0.714136f,  0.529136f},
+    {1.0f,  1.772f,     0.0f,      -0.886f},
+}}};
+
+inline constexpr colour_matrix sepia{{{
+    {0.393f, 0.769f, 0.189f, 0.0f},
+    {0.349f, 0.686f, 0.168f, 0.0f},
+    {0.272f, 0.534f, 0.131f, 0.0f},
+}}};
+
+/**
+ * Channel mixer, each argument holds the red, green and blue contributions to one output channel.
+ */
+constexpr auto channel_mixer(glm::vec3 const& red, glm::vec3 const& green, glm::vec3 const& blue) -> colour_matrix {
+    return {{{
+        {red.r,   red.g,   red.b,   0.0f},
+        {green.r, green.g, green.b, 0.0f},
+        {blue.r,  blue.g,  blue.b,  0.0f},
+    }}};
+}
+
+/**
+ * Apply a colour matrix in parallel row bands. The channel counts of source and destination may differ:
+ * one and two channel sources are read as grey, one and two channel destinations keep only the first row,
+ * and alpha is carried over when the destination has it (1.0 when the source has none).
+ * @param source      Image to transform.
+ * @param destination Output with the same width and height, the channel count selects the output layout.
+ * @param matrix      Colour transform.
+ */
+auto apply_colour_matrix(image const& source, image& destination, colour_matrix const& matrix) -> void;
+auto apply_colour_matrix(image const& source, colour_matrix const& matrix, std::int32_t const& channels) -> image;
+
+/**
+ * Rec.709 greyscale with one channel, or two when the source has alpha.
+ */
+auto greyscale(image const& source) -> image;
+}
+
+#endif  // IMAGEPP_COLOUR_HPP
@@ -0,0 +1,536 @@
+/**
+ * @file   deflate.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Parallel zlib/deflate compression and checksums
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "deflate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+constexpr std::size_t   window_size = 32768;
+constexpr std::size_t   window_mask = window_size - 1;
+constexpr std::int32_t  hash_bits   = 15;
+constexpr std::int32_t  min_match   = 3;
+constexpr std::int32_t  max_match   = 258;
+constexpr std::size_t   block_tokens = 1 << 14;
+constexpr std::size_t   stored_max  = 65535;
+
+constexpr std::array<std::uint16_t, 29> length_base{
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr std::array<std::uint8_t, 29> length_extra{
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr std::array<std::uint16_t, 30> distance_base{
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+    4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<std::uint8_t, 30> distance_extra{
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+// Order the code length code lengths are sent in.
+constexpr std::array<std::uint8_t, 19> code_length_order{16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// Per level search parameters in the spirit of zlib: chain length, match length that ends the search,
+// longest match that is still checked for a better one at the next byte (0 is greedy), and match length
+// that cuts that second search to a quarter chain.
+constexpr std::array<std::int32_t, 10> level_chain{0, 4, 8, 16, 32, 64, 128, 256, 1024, 4096};
+constexpr std::array<std::int32_t, 10> level_nice{0, 8, 16, 32, 32, 64, 128, 128, 258, 258};
+constexpr std::array<std::int32_t, 10> level_lazy{0, 0, 0, 0, 4, 16, 16, 32, 128, 258};
+constexpr std::array<std::int32_t, 10> level_good{0, 4, 4, 4, 4, 8, 8, 8, 32, 32};
+
+auto length_code(std::int32_t const& length) -> std::int32_t {
+    static auto const table = [] {
+        std::array<std::uint8_t, max_match + 1> codes{};
+        for (std::int32_t code = 0; code < 29; ++code)
+            for (auto l = length_base[static_cast<std::size_t>(code)]; l <= max_match; ++l) codes[l] = static_cast<std::uint8_t>(code);
+        return codes;
+    }();
+    return table[static_cast<std::size_t>(length)];
+}
+
+auto distance_code(std::int32_t const& distance) -> std::int32_t {
+    auto const it = std::upper_bound(distance_base.begin(), distance_base.end(), distance);
+    return static_cast<std::int32_t>(it - distance_base.begin()) - 1;
+}
+
+struct token {
+    std::uint16_t length;  // 0 for a literal
+    std::uint16_t value;   // literal byte or match distance
+};
+
+class bit_writer {
+  public:
+    bit_writer(std::vector<std::uint8_t>& out) : m_out(out) {}
+
+    auto put(std::uint32_t const& value, std::int32_t const& length) -> void {
+        m_bits  |= std::uint64_t{value} << m_count;
+        m_count += length;
+        while (m_count >= 8) {
+            m_out.push_back(static_cast<std::uint8_t>(m_bits));
+            m_bits  >>= 8;
+            m_count -= 8;
+        }
+    }
+    auto align() -> void {
+        if (m_count > 0) put(0, 8 - m_count);
+    }
+    // Raw bytes, only valid after align.
+    auto bytes(std::uint8_t const* data, std::size_t const& size) -> void {
+        m_out.insert(m_out.end(), data, data + size);
+    }
+
+  private:
+    std::vector<std::uint8_t>& m_out;
+    std::uint64_t              m_bits{0};
+    std::int32_t               m_count{0};
+};
+
+// Huffman code lengths limited to limit bits, unused symbols get length 0.
+auto build_lengths(std::uint32_t const* freq, std::int32_t const& count, std::int32_t const& limit, std::uint8_t* lengths) -> void {
+    std::fill_n(lengths, count, std::uint8_t{0});
+    std::vector<std::int32_t> used;
+    for (std::int32_t i = 0; i < count; ++i)
+        if (freq[i] > 0) used.push_back(i);
+    if (used.empty()) return;
+    if (used.size() == 1) {
+        // Two one bit codes keep the code complete, decoders reject some incomplete codes.
+        lengths[used[0]] = 1;
+        lengths[used[0] == 0 ? 1 : 0] = 1;
+        return;
+    }
+    std::sort(used.begin(), used.end(), [&](auto const& a, auto const& b) {
+        return freq[a] != freq[b] ? freq[a] < freq[b] : a < b;
+    });
+
+    // Two queue construction, leaves are sorted and internal nodes are created in weight order.
+    auto const n = used.size();
+    std::vector<std::uint64_t> weight(2 * n - 1);
+    std::vector<std::size_t>   parent(2 * n - 1, 0);
+    for (std::size_t i = 0; i < n; ++i) weight[i] = freq[used[i]];
+    std::size_t leaf = 0, node = n;
+    auto const pick = [&](std::size_t const& next) {
+        if (leaf < n && (node >= next || weight[leaf] <= weight[node])) return leaf++;
+        return node++;
+    };
+    for (auto next = n; next < 2 * n - 1; ++next) {
+        auto const a = pick(next);
+        auto const b = pick(next);
+        weight[next] = weight[a] + weight[b];
+        parent[a] = parent[b] = next;
+    }
+    std::vector<std::int32_t> depth(2 * n - 1, 0);
+    for (auto i = 2 * n - 1; i-- > 0;) depth[i] = i == 2 * n - 2 ? 0 : depth[parent[i]] + 1;
+
+    // Clamp to the limit and repair the Kraft sum by splitting shorter codes.
+    std::array<std::uint32_t, 16> bl_count{};
+    for (std::size_t i = 0; i < n; ++i) ++bl_count[static_cast<std::size_t>(std::min(depth[i], limit))];
+    std::uint32_t total = 0;
+    for (std::int32_t i = 1; i <= limit; ++i) total += bl_count[static_cast<std::size_t>(i)] << (limit - i);
+    while (total != (1u << limit)) {
+        --bl_count[static_cast<std::size_t>(limit)];
+        for (auto i = limit - 1; i > 0; --i) {
+            if (bl_count[static_cast<std::size_t>(i)] == 0) continue;
+            --bl_count[static_cast<std::size_t>(i)];
+            bl_count[static_cast<std::size_t>(i + 1)] += 2;
+            break;
+        }
+        --total;
+    }
+    // Rarest symbols take the longest codes.
+    std::size_t next = 0;
+    for (auto length = limit; length > 0; --length)
+        for (std::uint32_t i = 0; i < bl_count[static_cast<std::size_t>(length)]; ++i)
+            lengths[used[next++]] = static_cast<std::uint8_t>(length);
+}
+
+// Canonical codes, bit reversed because deflate sends Huffman codes most significant bit first.
+auto build_codes(std::uint8_t const* lengths, std::int32_t const& count, std::uint16_t* codes) -> void {
+    std::array<std::uint32_t, 16> bl_count{};
+    for (std::int32_t i = 0; i < count; ++i) ++bl_count[lengths[i]];
+    bl_count[0] = 0;
+    std::array<std::uint32_t, 16> next_code{};
+    std::uint32_t code = 0;
+    for (std::size_t bits = 1; bits < 16; ++bits) {
+        code = (code + bl_count[bits - 1]) << 1;
+        next_code[bits] = code;
+    }
+    for (std::int32_t i = 0; i < count; ++i) {
+        auto const length = lengths[i];
+        if (length == 0) continue;
+        auto value = next_code[length]++;
+        std::uint32_t reversed = 0;
+        for (std::int32_t b = 0; b < length; ++b, value >>= 1) reversed = (reversed << 1) | (value & 1);
+        codes[i] = static_cast<std::uint16_t>(reversed);
+    }
+}
+
+struct code_table {
+    std::array<std::uint8_t, 288>  literal_lengths{};
+    std::array<std::uint16_t, 288> literal_codes{};
+    std::array<std::uint8_t, 30>   distance_lengths{};
+    std::array<std::uint16_t, 30>  distance_codes{};
+};
+
+auto fixed_table() -> code_table const& {
+    static auto const table = [] {
+        code_table t;
+        for (std::size_t i = 0; i < 288; ++i) t.literal_lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+        t.distance_lengths.fill(5);
+        build_codes(t.literal_lengths.data(), 288, t.literal_codes.data());
+        build_codes(t.distance_lengths.data(), 30, t.distance_codes.data());
+        return t;
+    }();
+    return table;
+}
+
+auto write_tokens(bit_writer& out, code_table const& table, std::vector<token> const& tokens) -> void {
+    for (auto const& t : tokens) {
+        if (t.length == 0) {
+            out.put(table.literal_codes[t.value], table.literal_lengths[t.value]);
+            continue;
+        }
+        auto const lc = static_cast<std::size_t>(length_code(t.length));
+        out.put(table.literal_codes[257 + lc], table.literal_lengths[257 + lc]);
+        out.put(t.length - length_base[lc], length_extra[lc]);
+        auto const dc = static_cast<std::size_t>(distance_code(t.value));
+        out.put(table.distance_codes[dc], table.distance_lengths[dc]);
+        out.put(t.value - distance_base[dc], distance_extra[dc]);
+    }
+    out.put(table.literal_codes[256], table.literal_lengths[256]);
+}
+
+auto write_stored(bit_writer& out, std::uint8_t const* data, std::size_t const& size, bool const& final) -> void {
+    std::size_t offset = 0;
+    do {
+        auto const length = std::min(size - offset, stored_max);
+        out.put(final && offset + length == size ? 1 : 0, 1);
+        out.put(0, 2);
+        out.align();
+        out.put(static_cast<std::uint32_t>(length), 16);
+        out.put(static_cast<std::uint32_t>(~length & 0xFFFF), 16);
+        out.bytes(data + offset, length);
+        offset += length;
+    } while (offset < size);
+}
+
+// Emit one block as stored, fixed or dynamic Huffman, whichever is smallest.
+auto write_block(bit_writer& out, std::vector<token> const& tokens, std::uint8_t const* raw, std::size_t const& raw_size,
+                 bool const& final) -> void {
+    std::array<std::uint32_t, 286> literal_freq{};
+    std::array<std::uint32_t, 30>  distance_freq{};
+    std::uint64_t extra_bits = 0;
+    for (auto const& t : tokens) {
+        if (t.length == 0) {
+            ++literal_freq[t.value];
+            continue;
+        }
+        auto const lc = static_cast<std::size_t>(length_code(t.length));
+        auto const dc = static_cast<std::size_t>(distance_code(t.value));
+        ++literal_freq[257 + lc];
+        ++distance_freq[dc];
+        extra_bits += std::uint64_t{length_extra[lc]} + distance_extra[dc];
+    }
+    literal_freq[256] = 1;
+
+    auto const cost = [&](std::uint8_t const* literal_lengths, std::uint8_t const* distance_lengths) {
+        auto bits = extra_bits;
+        for (std::size_t i = 0; i < literal_freq.size(); ++i) bits += std::uint64_t{literal_freq[i]} * literal_lengths[i];
+        for (std::size_t i = 0; i < distance_freq.size(); ++i) bits += std::uint64_t{distance_freq[i]} * distance_lengths[i];
+        return bits;
+    };
+
+    code_table dynamic;
+    build_lengths(literal_freq.data(), 286, 15, dynamic.literal_lengths.data());
+    build_lengths(distance_freq.data(), 30, 15, dynamic.distance_lengths.data());
+    if (std::all_of(dynamic.distance_lengths.begin(), dynamic.distance_lengths.end(), [](auto const& l) { return l == 0; }))
+        dynamic.distance_lengths[0] = dynamic.distance_lengths[1] = 1;
+    std::int32_t hlit = 286, hdist = 30;
+    while (hlit > 257 && dynamic.literal_lengths[static_cast<std::size_t>(hlit - 1)] == 0) --hlit;
+    while (hdist > 1 && dynamic.distance_lengths[static_cast<std::size_t>(hdist - 1)] == 0) --hdist;
+
+    // Run length code the concatenated code lengths with symbols 16, 17 and 18.
+    struct run { std::uint8_t symbol, extra, bits; };
+    std::vector<std::uint8_t> all(dynamic.literal_lengths.begin(), dynamic.literal_lengths.begin() + hlit);
+    all.insert(all.end(), dynamic.distance_lengths.begin(), dynamic.distance_lengths.begin() + hdist);
+    std::vector<run> runs;
+    for (std::size_t i = 0; i < all.size();) {
+        auto const length = all[i];
+        std::size_t repeat = 1;
+        while (i + repeat < all.size() && all[i + repeat] == length) ++repeat;
+        i += repeat;
+        if (length == 0) {
+            while (repeat >= 11) {
+                auto const r = std::min<std::size_t>(repeat, 138);
+                runs.push_back({18, static_cast<std::uint8_t>(r - 11), 7});
+                repeat -= r;
+            }
+            if (repeat >= 3) {
+                runs.push_back({17, static_cast<std::uint8_t>(repeat - 3), 3});
+                repeat = 0;
+            }
+        } else {
+            runs.push_back({length, 0, 0});
+            --repeat;
+            while (repeat >= 3) {
+                auto const r = std::min<std::size_t>(repeat, 6);
+                runs.push_back({16, static_cast<std::uint8_t>(r - 3), 2});
+                repeat -= r;
+            }
+        }
+        for (; repeat > 0; --repeat) runs.push_back({length, 0, 0});
+    }
+    std::array<std::uint32_t, 19>  length_freq{};
+    for (auto const& r : runs) ++length_freq[r.symbol];
+    std::array<std::uint8_t, 19>  length_lengths{};
+    std::array<std::uint16_t, 19> length_codes{};
+    build_lengths(length_freq.data(), 19, 7, length_lengths.data());
+    build_codes(length_lengths.data(), 19, length_codes.data());
+    std::int32_t hclen = 19;
+    while (hclen > 4 && length_lengths[code_length_order[static_cast<std::size_t>(hclen - 1)]] == 0) --hclen;
+
+    std::uint64_t header_bits = 5 + 5 + 4 + 3 * static_cast<std::uint64_t>(hclen);
+    for (auto const& r : runs) header_bits += std::uint64_t{length_lengths[r.symbol]} + r.bits;
+    auto const dynamic_bits = header_bits + cost(dynamic.literal_lengths.data(), dynamic.distance_lengths.data());
+    auto const& fixed       = fixed_table();
+    auto const fixed_bits   = cost(fixed.literal_lengths.data(), fixed.distance_lengths.data());
+    auto const stored_bits  = raw_size * 8 + (raw_size / stored_max + 1) * 40;
+
+    if (stored_bits <= std::min(dynamic_bits, fixed_bits)) {
+        write_stored(out, raw, raw_size, final);
+        return;
+    }
+    out.put(final ? 1 : 0, 1);
+    if (fixed_bits <= dynamic_bits) {
+        out.put(1, 2);
+        write_tokens(out, fixed, tokens);
+        return;
+    }
+    out.put(2, 2);
+    out.put(static_cast<std::uint32_t>(hlit - 257), 5);
+    out.put(static_cast<std::uint32_t>(hdist - 1), 5);
+    out.put(static_cast<std::uint32_t>(hclen - 4), 4);
+    for (std::int32_t i = 0; i < hclen; ++i) out.put(length_lengths[code_length_order[static_cast<std::size_t>(i)]], 3);
+    for (auto const& r : runs) {
+        out.put(length_codes[r.symbol], length_lengths[r.symbol]);
+        out.put(r.extra, r.bits);
+    }
+    build_codes(dynamic.literal_lengths.data(), 286, dynamic.literal_codes.data());
+    build_codes(dynamic.distance_lengths.data(), 30, dynamic.distance_codes.data());
+    write_tokens(out, dynamic, tokens);
+}
+
+// Length of the common prefix, eight bytes at a time on little endian targets.
+auto common_length(std::uint8_t const* a, std::uint8_t const* b, std::int32_t const& limit) -> std::int32_t {
+    std::int32_t length = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; length + 8 <= limit; length += 8) {
+            std::uint64_t x, y;
+            std::memcpy(&x, a + length, sizeof(x));
+            std::memcpy(&y, b + length, sizeof(y));
+            if (x != y) return length + std::countr_zero(x ^ y) / 8;
+        }
+    }
+    while (length < limit && a[length] == b[length]) ++length;
+    return length;
+}
+
+auto hash3(std::uint8_t const* p) -> std::size_t {
+    auto const value = std::uint32_t{p[0]} | std::uint32_t{p[1]} << 8 | std::uint32_t{p[2]} << 16;
+    return (value * 2654435761u) >> (32 - hash_bits);
+}
+
+// Deflate [begin, end) of data. The hash chains are seeded with the 32 KiB before begin so matches can reach
+// into the previous chunk, the decoder has that data since chunks are concatenated into one stream.
+auto compress_chunk(std::uint8_t const* data, std::size_t const& begin, std::size_t const& end,
+                    std::int32_t const& level, bool const& final) -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> result;
+    result.reserve((end - begin) / 2 + 64);
+    bit_writer out{result};
+
+    auto const origin = begin > window_size ? begin - window_size : 0;
+    thread_local std::vector<std::int32_t> head;
+    thread_local std::vector<std::int32_t> prev;
+    head.assign(std::size_t{1} << hash_bits, -1);
+    prev.assign(window_size, -1);
+
+    auto const insert = [&](std::size_t const& p) {
+        if (p + 2 >= end) return;
+        auto const h = hash3(data + p);
+        prev[p & window_mask] = head[h];
+        head[h] = static_cast<std::int32_t>(p - origin);
+    };
+    struct match { std::int32_t length, distance; };
+    auto const max_chain = level_chain[static_cast<std::size_t>(level)];
+    auto const nice      = level_nice[static_cast<std::size_t>(level)];
+    auto const max_lazy  = level_lazy[static_cast<std::size_t>(level)];
+    auto const good      = level_good[static_cast<std::size_t>(level)];
+    auto const find = [&](std::size_t const& p, std::int32_t const& chain_length) -> match {
+        if (p + min_match > end) return {0, 0};
+        auto const limit   = static_cast<std::int32_t>(std::min<std::size_t>(max_match, end - p));
+        auto const nearest = static_cast<std::int64_t>(std::max(origin, p > window_size ? p - window_size : 0) - origin);
+        auto candidate = static_cast<std::int64_t>(head[hash3(data + p)]);
+        match best{min_match - 1, 0};
+        for (auto chain = chain_length; candidate >= nearest && chain > 0; --chain) {
+            auto const* a = data + origin + static_cast<std::size_t>(candidate);
+            auto const* b = data + p;
+            if (a[best.length] == b[best.length] && a[0] == b[0]) {
+                auto const length = common_length(a, b, limit);
+                if (length > best.length) {
+                    best = {length, static_cast<std::int32_t>(b - a)};
+                    if (length >= nice || length == limit) break;
+                }
+            }
+            auto const next = static_cast<std::int64_t>(prev[(origin + static_cast<std::size_t>(candidate)) & window_mask]);
+            if (next >= candidate) break;  // Slot reused by a newer position, the chain ends here.
+            candidate = next;
+        }
+        return best.length >= min_match ? best : match{0, 0};
+    };
+
+    for (auto p = origin; p < begin; ++p) insert(p);
+
+    std::vector<token> tokens;
+    tokens.reserve(block_tokens);
+    auto block_start = begin;
+    match next{0, 0};
+    bool has_next = false;
+    for (auto p = begin; p < end;) {
+        auto const current = has_next ? next : find(p, max_chain);
+        has_next = false;
+        insert(p);
+        if (current.length >= min_match && current.length < max_lazy && p + 1 < end) {
+            next = find(p + 1, current.length >= good ? max_chain / 4 : max_chain);
+            has_next = true;
+            if (next.length > current.length) {
+                tokens.push_back({0, data[p]});
+                ++p;
+                continue;
+            }
+        }
+        if (current.length >= min_match) {
+            tokens.push_back({static_cast<std::uint16_t>(current.length), static_cast<std::uint16_t>(current.distance)});
+            for (auto q = p + 1; q < p + static_cast<std::size_t>(current.length); ++q) insert(q);
+            p += static_cast<std::size_t>(current.length);
+            has_next = false;
+        } else {
+            tokens.push_back({0, data[p]});
+            ++p;
+        }
+        if (tokens.size() >= block_tokens && !has_next) {
+            write_block(out, tokens, data + block_start, p - block_start, false);
+            tokens.clear();
+            block_start = p;
+        }
+    }
+    write_block(out, tokens, data + block_start, end - block_start, final);
+    if (!final) {
+        // Sync flush, an empty stored block leaves the chunk byte aligned.
+        out.put(0, 3);
+        out.align();
+        out.put(0x0000, 16);
+        out.put(0xFFFF, 16);
+    }
+    out.align();
+    return result;
+}
+
+auto store_chunk(std::uint8_t const* data, std::size_t const& begin, std::size_t const& end, bool const& final) -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> result;
+    result.reserve(end - begin + (end - begin) / stored_max * 5 + 5);
+    bit_writer out{result};
+    write_stored(out, data + begin, end - begin, final);
+    return result;
+}
+}
+
+auto adler32(std::uint8_t const* data, std::size_t const& size, std::uint32_t const& adler) -> std::uint32_t {
+    constexpr std::uint32_t base = 65521;
+    constexpr std::size_t   nmax = 5552;  // Largest run before the sums can overflow 32 bits.
+    std::uint32_t a = adler & 0xFFFF;
+    std::uint32_t b = adler >> 16;
+    for (std::size_t offset = 0; offset < size;) {
+        auto const run = std::min(size - offset, nmax);
+        for (std::size_t i = 0; i < run; ++i) {
+            a += data[offset + i];
+            b += a;
+        }
+        a %= base;
+        b %= base;
+        offset += run;
+    }
+    return a | (b << 16);
+}
+
+auto adler32_combine(std::uint32_t const& first, std::uint32_t const& second, std::size_t const& second_size) -> std::uint32_t {
+    constexpr std::uint32_t base = 65521;
+    auto const remainder = static_cast<std::uint32_t>(second_size % base);
+    std::uint32_t a = first & 0xFFFF;
+    std::uint32_t b = static_cast<std::uint32_t>((std::uint64_t{remainder} * a) % base);
+    a += (second & 0xFFFF) + base - 1;
+    b += ((first >> 16) & 0xFFFF) + ((second >> 16) & 0xFFFF) + base - remainder;
+    if (a >= base) a -= base;
+    if (a >= base) a -= base;
+    if (b >= base << 1) b -= base << 1;
+    if (b >= base) b -= base;
+    return a | (b << 16);
+}
+
+auto crc32(std::uint8_t const* data, std::size_t const& size, std::uint32_t const& crc) -> std::uint32_t {
+    static auto const table = [] {
+        std::array<std::uint32_t, 256> values{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            auto c = i;
+            for (std::int32_t k = 0; k < 8; ++k) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            values[i] = c;
+        }
+        return values;
+    }();
+    auto c = ~crc;
+    for (std::size_t i = 0; i < size; ++i) c = table[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    return ~c;
+}
+
+auto zlib_compress(std::uint8_t const* data, std::size_t const& size, deflate_options const& options) -> std::vector<std::uint8_t> {
+    auto const level = std::clamp(options.level, 0, 9);
+    auto const chunk = std::max(options.chunk_size, window_size);
+    auto const count = static_cast<std::int32_t>(std::max<std::size_t>((size + chunk - 1) / chunk, 1));
+
+    std::vector<std::vector<std::uint8_t>> parts(static_cast<std::size_t>(count));
+    std::vector<std::uint32_t> adlers(static_cast<std::size_t>(count));
+    parallel_for(count, [&](std::int32_t const& index) {
+        auto const i     = static_cast<std::size_t>(index);
+        auto const begin = std::min(i * chunk, size);
+        auto const end   = std::min(begin + chunk, size);
+        auto const final = index == count - 1;
+        parts[i]  = level == 0 ? store_chunk(data, begin, end, final) : compress_chunk(data, begin, end, level, final);
+        adlers[i] = adler32(data + begin, end - begin);
+    });
+
+    std::vector<std::uint8_t> result;
+    auto const total = std::accumulate(parts.begin(), parts.end(), std::size_t{6},
+                                       [](auto const& sum, auto const& part) { return sum + part.size(); });
+    result.reserve(total);
+    // CMF 0x78 is deflate with a 32 KiB window, FLEVEL hints the level and FCHECK makes the header divisible by 31.
+    auto const flevel = level < 2 ? 0u : level < 6 ? 1u : level == 6 ? 2u : 3u;
+    auto flags = flevel << 6;
+    flags += 31 - ((0x78u << 8) | flags) % 31;
+    result.push_back(0x78);
+    result.push_back(static_cast<std::uint8_t>(flags));
+    auto adler = std::uint32_t{1};
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        result.insert(result.end(), parts[i].begin(), parts[i].end());
+        auto const begin = std::min(i * chunk, size);
+        adler = adler32_combine(adler, adlers[i], std::min(begin + chunk, size) - begin);
+    }
+    for (std::int32_t shift = 24; shift >= 0; shift -= 8) result.push_back(static_cast<std::uint8_t>(adler >> shift));
+    return result;
+}
+}
@@ -0,0 +1,48 @@
+/**
+ * @file   deflate.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Parallel zlib/deflate compression and checksums
+ *         https://www.rfc-editor.org/rfc/rfc1950
+ *         https://www.rfc-editor.org/rfc/rfc1951
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_DEFLATE_HPP
+#define IMAGEPP_DEFLATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nrv {
+/**
+ * Adler-32 of a buffer, continuing from a previous value.
+ */
+auto adler32(std::uint8_t const* data, std::size_t const& size, std::uint32_t const& adler = 1) -> std::uint32_t;
+
+/**
+ * Adler-32 of two concatenated buffers from the checksums of the parts.
+ * @param second_size Size of the second buffer.
+ */
+auto adler32_combine(std::uint32_t const& first, std::uint32_t const& second, std::size_t const& second_size) -> std::uint32_t;
+
+/**
+ * CRC-32 (ISO 3309) of a buffer, continuing from a previous value.
+ */
+auto crc32(std::uint8_t const* data, std::size_t const& size, std::uint32_t const& crc = 0) -> std::uint32_t;
+
+struct deflate_options {
+    std::int32_t level{6};          // 0 stores, 1 is the fastest and 9 the smallest
+    std::size_t  chunk_size{1 << 17};  // Input bytes per parallel chunk
+};
+
+/**
+ * Compress into a zlib stream. The input is split into chunks that are compressed in parallel as
+ * independent runs of deflate blocks joined by sync flushes. Matches may still reach back into the
+ * previous chunk, so the ratio stays close to a serial stream.
+ */
+auto zlib_compress(std::uint8_t const* data, std::size_t const& size, deflate_options const& options = {}) -> std::vector<std::uint8_t>;
+}
+
+#endif  // IMAGEPP_DEFLATE_HPP
@@ -11,12 +11,15 @@
 #include <numbers>
 #include <vector>
 #include <stack>
+#include <string>
 #include <functional>
+#include <optional>
 #include <random>
 #include <filesystem>
 #include <stdexcept>
 #include <thread>
 #include <chrono>
+#include <utility>
 
 #include <cstdint>
 #include <cmath>
@@ -25,6 +28,42 @@
 #include "asio.hpp"
 
 #include "image.hpp"
+#include "bitmap.hpp"
+#include "blur.hpp"
+#include "colour.hpp"
+#include "fit.hpp"
+#include "histogram.hpp"
+#include "lut.hpp"
+#include "png.hpp"
+#include "qoi.hpp"
+#include "raw.hpp"
+#include "threshold.hpp"
+#include "tone.hpp"
+
+// The whole argument as a number, std::nullopt when it is not one or has trailing characters.
+auto parse_float(std::string const& text) -> std::optional<float> {
+    std::size_t used = 0;
+    float value = 0.0f;
+    try {
+        value = std::stof(text, &used);
+    } catch (std::exception const&) {
+        return std::nullopt;
+    }
+    if (used != text.size()) return std::nullopt;
+    return value;
+}
+
+auto parse_int(std::string const& text) -> std::optional<std::int32_t> {
+    std::size_t used = 0;
+    std::int32_t value = 0;
+    try {
+        value = std::stoi(text, &used);
+    } catch (std::exception const&) {
+        return std::nullopt;
+    }
+    if (used != text.size()) return std::nullopt;
+    return value;
+}
 
 auto dither_floyd_steinberg(nrv::image const& source, nrv::image& destination, std::function<glm::vec4(glm::vec4 const& pixel)> const& quantise_fn) {
     std::memcpy(destination.buffer(), source.buffer(), source.size() * sizeof(float));
@@ -78,42 +117,145 @@ auto dither_minimized_average_error(nrv::image const& source, nrv::image& out, s
 }
 
 auto main([[maybe_unused]]int argc, [[maybe_unused]]char const* argv[]) -> int {
-    if (argc < 2) {
+    std::vector<std::string> args{};
+    float sharpen = 0.0f;
+    float gamma   = 1.0f;
+    bool levels   = false;
+    std::int32_t panel_width  = 0;
+    std::int32_t panel_height = 0;
+    std::string threshold_mode{};
+    std::string cube{};
+    std::string format = "png";
+    std::string cache{};
+
+    auto const print_usage = [&] {
+        std::cerr << "usage: " << argv[0] << " [filename] [ip] [--sharpen amount] [--gamma value] [--levels] [--panel WxH] [--threshold mode] [--cube file] [--format png|qoi] [--cache file]\n";
+        std::cerr << "    [filename]  - path to image file, supported (jpg, png, qoi, nrv or stb_image supported type)\n";
+        std::cerr << "    [ip]        - address of the display to send the dithered image to\n";
+        std::cerr << "    --sharpen   - unsharp mask strength applied before dithering, default 0 (off)\n";
+        std::cerr << "    --gamma     - panel response compensation applied to the greyscale image, default 1 (off)\n";
+        std::cerr << "    --levels    - stretch the greyscale image between its 0.5 and 99.5 percentiles\n";
+        std::cerr << "    --panel     - letterbox the image into a WxH display frame before dithering\n";
+        std::cerr << "    --threshold - quantise_out level: otsu (default), bradley, sauvola or a fixed value, a given mode\n";
+        std::cerr << "                  also moves the dither level from 0.5 to the Otsu or fixed level\n";
+        std::cerr << "    --cube      - .cube colour grade applied before the greyscale conversion\n";
+        std::cerr << "    --format    - output file format, png (1-bit for the binary outputs, default) or qoi\n";
+        std::cerr << "    --cache     - save the decoded image as a .nrv file, later runs map it instead of decoding\n";
+    };
+    for (auto i = 1; i < argc; ++i) {
+        std::string const arg = argv[i];
+        if (arg == "--sharpen" && i + 1 < argc) {
+            auto const value = parse_float(argv[++i]);
+            if (!value) {
+                std::cerr << "sharpen amount must be a number, got \"" << argv[i] << "\"\n\n";
+                print_usage();
+                return 1;
+            }
+            sharpen = *value;
+        } else if (arg == "--gamma" && i + 1 < argc) {
+            auto const value = parse_float(argv[++i]);
+            if (!value || !(*value > 0.0f)) {
+                std::cerr << "gamma must be a positive number, got \"" << argv[i] << "\"\n\n";
+                print_usage();
+                return 1;
+            }
+            gamma = *value;
+        } else if (arg == "--levels") {
+            levels = true;
+        } else if (arg == "--panel" && i + 1 < argc) {
+            std::string const size = argv[++i];
+            auto const split = size.find('x');
+            auto const width  = split == std::string::npos ? std::nullopt : parse_int(size.substr(0, split));
+            auto const height = split == std::string::npos ? std::nullopt : parse_int(size.substr(split + 1));
+            if (!width || !height || *width < 1 || *height < 1) {
+                std::cerr << "panel size must be given as {width}x{height} with positive sizes, got \"" << size << "\"\n\n";
+                print_usage();
+                return 1;
+            }
+            panel_width  = *width;
+            panel_height = *height;
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            threshold_mode = argv[++i];
+        } else if (arg == "--cube" && i + 1 < argc) {
+            cube = argv[++i];
+        } else if (arg == "--format" && i + 1 < argc) {
+            format = argv[++i];
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cache = argv[++i];
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    if (format != "png" && format != "qoi") {
+        std::cerr << "unknown output format \"" << format << "\", expected png or qoi\n";
+        return 1;
+    }
+    // Anything but a named mode must be a number, checked before the image is decoded.
+    std::optional<float> fixed_level{};
+    if (!threshold_mode.empty() && threshold_mode != "otsu" && threshold_mode != "bradley" && threshold_mode != "sauvola") {
+        fixed_level = parse_float(threshold_mode);
+        if (!fixed_level) {
+            std::cerr << "unknown threshold mode \"" << threshold_mode << "\"\n\n";
+            print_usage();
+            return 1;
+        }
+    }
+    if (args.empty()) {
         std::cerr << "error no file given!\n\n";
-        std::cerr << "usage: " << argv[0] << " [filename]\n";
-        std::cerr << "    [filename] - path to image file, supported (jpg, png, or stb_image supported type)\n";
+        print_usage();
         return 1;
     }
 
-    std::string filename = argv[1];
+    std::string filename = args[0];
     if (!std::filesystem::exists(filename)) {
         std::cerr << "file: \"" << filename << "\" does not exists\n";
         return 1;
     }
 
-    nrv::image img{filename};
+    // Native files are mapped and used in place, the first transform below copies out of the mapping.
+    std::optional<nrv::mapped_image> mapped{};
+    if (std::filesystem::path{filename}.extension() == ".nrv") mapped.emplace(filename);
+    nrv::image img = mapped ? mapped->view() : nrv::image{filename};
+    if (!cache.empty()) nrv::write_raw(cache, img);
+    if (panel_width > 0 && panel_height > 0) {
+        nrv::image frame{panel_width, panel_height, img.channels()};
+        nrv::fit_to_frame(img, frame);
+        img = std::move(frame);
+    }
+    if (!cube.empty() && img.channels() >= 3) nrv::apply_lut(img, img, nrv::load_cube(cube));
+    img = nrv::greyscale(img);
+    if (levels) nrv::auto_levels(img, img);
+    if (gamma != 1.0f) nrv::apply_lut(img, img, nrv::compile_curve(nrv::gamma_curve(gamma)));
+    if (sharpen > 0.0f) img = nrv::unsharp_mask(img, sharpen, 1.0f);
     nrv::image quantised{img.width(), img.height(), img.channels()};
     nrv::image dithered{img.width(), img.height(), img.channels()};
 
-    auto rgb_to_greyscale = [](glm::i32vec2 const&, glm::vec4 const& pixel) {
-        float greyscale = 0.2162f * pixel.r + 0.7152f * pixel.g + 0.0722f * pixel.b;
-        return glm::vec4(greyscale);
+    // quantise_out defaults to Otsu, adaptive modes binarise against their window and dither at the Otsu level.
+    // Without --threshold the dither quantiser keeps the 0.5 midpoint.
+    auto const level        = fixed_level ? *fixed_level : nrv::otsu_threshold(img);
+    auto const dither_level = threshold_mode.empty() ? 0.5f : level;
+    auto quantise_greyscale_1bit = [dither_level](glm::vec4 const& in) {
+        return in.r < dither_level ? glm::vec4{0.0f} : glm::vec4{1.0f};
     };
-    nrv::render_transform(img, img, rgb_to_greyscale);
-
-    auto quantise_greyscale_1bit = [](glm::vec4 const& in) {
-        return in.r < 0.5f ? glm::vec4{0.0f} : glm::vec4{1.0f};
-    };
-    nrv::render_transform(img, quantised, quantise_greyscale_1bit);
+    if (threshold_mode == "bradley")      nrv::bradley_threshold(img, quantised);
+    else if (threshold_mode == "sauvola") nrv::sauvola_threshold(img, quantised);
+    else                                  nrv::threshold(img, quantised, level);
     dither_floyd_steinberg(img, dithered, quantise_greyscale_1bit);
     //dither_minimized_average_error(img, dithered, quantise_greyscale_1bit);
 
-    nrv::write_png("greyscale_out.png", img);
-    nrv::write_png("quantise_out.png", quantised);
-    nrv::write_png("dithered_out.png", dithered);
+    if (format == "qoi") {
+        nrv::write_qoi("greyscale_out.qoi", img);
+        nrv::write_qoi("quantise_out.qoi", quantised);
+        nrv::write_qoi("dithered_out.qoi", dithered);
+    } else {
+        nrv::write_png("greyscale_out.png", img);
+        nrv::write_png("quantise_out.png", nrv::bitmap{quantised});
+        nrv::write_png("dithered_out.png", nrv::bitmap{dithered});
+    }
 
-    if (argc < 3) return 0;
-    std::string ip = argv[2];
+    if (args.size() < 2) return 0;
+    std::string ip = args[1];
 
     asio::error_code ec;
     asio::io_context io;
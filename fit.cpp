@@ -0,0 +1,56 @@
+/**
+ * @file   fit.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Fit images into a fixed display frame
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "fit.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "parallel.hpp"
+
+namespace nrv {
+auto fit_to_frame(image const& source, image& frame, fit_mode const& mode, glm::vec4 const& background, resample_filter const& filter) -> void {
+    auto const sx = static_cast<float>(frame.width())  / static_cast<float>(source.width());
+    auto const sy = static_cast<float>(frame.height()) / static_cast<float>(source.height());
+    auto const scale  = mode == fit_mode::contain ? std::min(sx, sy) : std::max(sx, sy);
+    auto const width  = std::max(1, static_cast<std::int32_t>(std::lround(static_cast<float>(source.width())  * scale)));
+    auto const height = std::max(1, static_cast<std::int32_t>(std::lround(static_cast<float>(source.height()) * scale)));
+
+    // Offset of the scaled image in the frame, negative when it overflows and gets cropped.
+    auto const ox = (frame.width()  - width)  / 2;
+    auto const oy = (frame.height() - height) / 2;
+    auto const x0 = std::max(ox, 0);
+    auto const y0 = std::max(oy, 0);
+    auto const x1 = std::min(ox + width,  frame.width());
+    auto const y1 = std::min(oy + height, frame.height());
+
+    // Padding, only the pixels the image does not cover.
+    auto const channels = frame.channels();
+    float const colour[4] = {background.r, background.g, background.b, background.a};
+    auto const pad = [&](float* out, std::int32_t const& count) {
+        for (std::int32_t i = 0; i < count; ++i)
+            for (std::int32_t c = 0; c < channels; ++c) out[i * channels + c] = colour[std::min(c, 3)];
+    };
+    parallel_for_range(frame.height(), 32, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto* row = frame.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(frame.width() * channels);
+            if (y < y0 || y >= y1) {
+                pad(row, frame.width());
+                continue;
+            }
+            pad(row, x0);
+            pad(row + x1 * channels, frame.width() - x1);
+        }
+    });
+
+    // Visible window of the scaled image, written straight into the frame.
+    resample_weights const columns{source.width(),  width,  filter, x0 - ox, x1 - x0};
+    resample_weights const rows{source.height(), height, filter, y0 - oy, y1 - y0};
+    resample(source, frame, columns, rows, x0, y0);
+}
+}
@@ -0,0 +1,37 @@
+/**
+ * @file   fit.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Fit images into a fixed display frame
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_FIT_HPP
+#define IMAGEPP_FIT_HPP
+
+#include "glm/glm.hpp"
+
+#include "image.hpp"
+#include "resample.hpp"
+
+namespace nrv {
+enum class fit_mode {
+    contain,  // whole image visible, letterboxed with the background colour
+    cover,    // frame filled, the overflowing part is cropped
+};
+
+/**
+ * Scale the source preserving its aspect ratio, centre it in the frame and convert it to the frame's
+ * channel count in one pass over the frame. Only the visible part of the scaled image is computed and
+ * the padding is written once, no intermediate full size image exists.
+ * @param source     Image to fit.
+ * @param frame      Panel frame, usually the buffer the dither stage reads, same channels as source or 1.
+ * @param mode       Letterbox or crop.
+ * @param background Padding colour, a single channel frame uses background.r.
+ * @param filter     Reconstruction filter for the scaling.
+ */
+auto fit_to_frame(image const& source, image& frame, fit_mode const& mode = fit_mode::contain,
+                  glm::vec4 const& background = glm::vec4{1.0f}, resample_filter const& filter = resample_filter::lanczos3) -> void;
+}
+
+#endif  // IMAGEPP_FIT_HPP
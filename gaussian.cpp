@@ -2,15 +2,50 @@
  * @file   gaussian.cpp
  * @author mononerv (me@mononerv.dev)
  * @brief  Gaussian blur
+ *         https://en.wikipedia.org/wiki/Gaussian_blur
  * @date   2022-10-14
  *
  * @copyright Copyright (c) 2022 mononerv
  */
+#include <filesystem>
 #include <iostream>
+#include <string>
 
 #include "image.hpp"
+#include "blur.hpp"
+#include "qoi.hpp"
 
 auto main([[maybe_unused]]int argc, [[maybe_unused]]char const* argv[]) -> int {
-    std::cout << "Gaussian blur\n";
+    if (argc < 2) {
+        std::cout << "No file given\n";
+        std::cout << "usage: " << argv[0] << " {filename} [sigma] [format]\n";
+        std::cout << "    [format] - png (default) or qoi\n";
+        return 1;
+    }
+
+    std::filesystem::path filename = argv[1];
+    if (!std::filesystem::exists(filename)) {
+        std::cout << "Not a valid file\n";
+        return 1;
+    }
+
+    float sigma = 2.0f;
+    if (argc > 2) sigma = std::stof(argv[2]);
+    if (!(sigma > 0.0f)) {
+        std::cout << "sigma must be positive\n";
+        return 1;
+    }
+
+    std::string const format = argc > 3 ? argv[3] : "png";
+    if (format != "png" && format != "qoi") {
+        std::cout << "format must be png or qoi\n";
+        return 1;
+    }
+
+    nrv::image image{filename};
+    auto out = nrv::gaussian_blur(image, sigma);
+    if (format == "qoi") nrv::write_qoi("gaussian_out.qoi", out);
+    else                 nrv::write_png("gaussian_out.png", out);
+
     return 0;
 }
@@ -0,0 +1,99 @@
+/**
+ * @file   guided.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Guided filter
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "guided.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "blur.hpp"
+#include "parallel.hpp"
+
+namespace nrv {
+auto guided_filter(image const& guide, image const& source, image& destination, std::int32_t const& radius, float const& epsilon) -> void {
+    if (guide.width() != source.width() || guide.height() != source.height() ||
+        (guide.channels() != 1 && guide.channels() != source.channels()))
+        throw std::invalid_argument("nrv::guided_filter: guide must match the source size and channels or have one channel");
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::guided_filter: source and destination dimensions differ");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+    auto const guide_at = [&](std::size_t const& p, std::int32_t const& c) {
+        return guide.channels() == 1 ? guide.buffer()[p] : guide.buffer()[p * static_cast<std::size_t>(channels) + static_cast<std::size_t>(c)];
+    };
+
+    // Pack I, p, I * I and I * p of every channel so one box blur produces all four means.
+    auto const packed = 4 * channels;
+    image moments{width, height, packed};
+    image means{width, height, packed};
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto p = static_cast<std::size_t>(begin) * static_cast<std::size_t>(width); p < static_cast<std::size_t>(end) * static_cast<std::size_t>(width); ++p) {
+            auto* m = moments.buffer() + p * static_cast<std::size_t>(packed);
+            auto const* in = source.buffer() + p * static_cast<std::size_t>(channels);
+            for (std::int32_t c = 0; c < channels; ++c) {
+                auto const i = guide_at(p, c);
+                m[4 * c + 0] = i;
+                m[4 * c + 1] = in[c];
+                m[4 * c + 2] = i * i;
+                m[4 * c + 3] = i * in[c];
+            }
+        }
+    });
+    box_blur(moments, means, radius);
+
+    // Per window linear model q = a * I + b, then average the models covering every pixel.
+    auto const model = 2 * channels;
+    image coefficients{width, height, model};
+    image averaged{width, height, model};
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto p = static_cast<std::size_t>(begin) * static_cast<std::size_t>(width); p < static_cast<std::size_t>(end) * static_cast<std::size_t>(width); ++p) {
+            auto const* m = means.buffer() + p * static_cast<std::size_t>(packed);
+            auto* ab = coefficients.buffer() + p * static_cast<std::size_t>(model);
+            for (std::int32_t c = 0; c < channels; ++c) {
+                auto const mean_i   = m[4 * c + 0];
+                auto const mean_p   = m[4 * c + 1];
+                auto const variance = m[4 * c + 2] - mean_i * mean_i;
+                auto const cov      = m[4 * c + 3] - mean_i * mean_p;
+                auto const a        = cov / (variance + epsilon);
+                ab[2 * c + 0] = a;
+                ab[2 * c + 1] = mean_p - a * mean_i;
+            }
+        }
+    });
+    box_blur(coefficients, averaged, radius);
+
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto p = static_cast<std::size_t>(begin) * static_cast<std::size_t>(width); p < static_cast<std::size_t>(end) * static_cast<std::size_t>(width); ++p) {
+            auto const* ab = averaged.buffer() + p * static_cast<std::size_t>(model);
+            auto* out = destination.buffer() + p * static_cast<std::size_t>(channels);
+            for (std::int32_t c = 0; c < channels; ++c)
+                out[c] = ab[2 * c + 0] * guide_at(p, c) + ab[2 * c + 1];
+        }
+    });
+}
+
+auto guided_filter(image const& source, std::int32_t const& radius, float const& epsilon) -> image {
+    image output{source.width(), source.height(), source.channels()};
+    guided_filter(source, source, output, radius, epsilon);
+    return output;
+}
+
+auto detail_enhance(image const& source, image& destination, std::int32_t const& radius, float const& epsilon, float const& amount) -> void {
+    guided_filter(source, source, destination, radius, epsilon);
+    parallel_for_range(source.height(), 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        auto const row = static_cast<std::size_t>(source.width() * source.channels());
+        for (auto i = static_cast<std::size_t>(begin) * row; i < static_cast<std::size_t>(end) * row; ++i) {
+            auto const base = destination.buffer()[i];
+            destination.buffer()[i] = std::clamp(base + amount * (source.buffer()[i] - base), 0.0f, 1.0f);
+        }
+    });
+}
+}
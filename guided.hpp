@@ -0,0 +1,36 @@
+/**
+ * @file   guided.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Guided filter
+ *         He, Sun & Tang, Guided Image Filtering, 2010
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_GUIDED_HPP
+#define IMAGEPP_GUIDED_HPP
+
+#include <cstdint>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Edge aware smoothing of source steered by the edges of guide. Built from two sliding window box
+ * blurs over packed channels, the cost per pixel does not depend on the radius.
+ * @param guide       Guide image, channel c steers source channel c, a single channel guide steers all of them.
+ * @param source      Image to filter, same size as guide.
+ * @param destination Filtered output, same dimensions as source.
+ * @param radius      Box radius in pixels.
+ * @param epsilon     Regularisation, edges with a variance well above epsilon are preserved.
+ */
+auto guided_filter(image const& guide, image const& source, image& destination, std::int32_t const& radius, float const& epsilon) -> void;
+auto guided_filter(image const& source, std::int32_t const& radius, float const& epsilon) -> image;
+
+/**
+ * Boost the detail the guided filter removes: base + amount * (source - base) with base the self guided result.
+ */
+auto detail_enhance(image const& source, image& destination, std::int32_t const& radius, float const& epsilon, float const& amount) -> void;
+}
+
+#endif  // IMAGEPP_GUIDED_HPP
@@ -0,0 +1,228 @@
+/**
+ * @file   histogram.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Histograms, histogram equalisation and CLAHE
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "histogram.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include "lut.hpp"
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+// Count rows in private per band histograms and merge them once, bands never share a counter.
+template <typename count_fn_t>
+auto banded_histogram(image const& source, std::int32_t const& channels, std::int32_t const& bins,
+                      count_fn_t const& count) -> histogram {
+    auto const height = source.height();
+    auto const width  = source.width();
+    auto const stride = source.channels();
+    auto const bands  = std::clamp(height / 32, 1, static_cast<std::int32_t>(default_pool().size()) * 4);
+    std::vector<histogram> locals(static_cast<std::size_t>(bands), histogram(channels, bins));
+    parallel_for(bands, [&](std::int32_t const& band) {
+        auto const begin = static_cast<std::int32_t>(std::int64_t{height} * band / bands);
+        auto const end   = static_cast<std::int32_t>(std::int64_t{height} * (band + 1) / bands);
+        auto& local = locals[static_cast<std::size_t>(band)];
+        for (auto y = begin; y < end; ++y) {
+            auto const* row = source.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(width * stride);
+            for (std::int32_t x = 0; x < width; ++x) count(row + x * stride, local);
+        }
+    });
+    for (std::size_t i = 1; i < locals.size(); ++i) locals[0].merge(locals[i]);
+    return std::move(locals[0]);
+}
+
+// Equalisation table from counts, the first occupied bin maps to 0 and the last to 1.
+auto equalisation_table(std::uint64_t const* counts, std::int32_t const& bins, float* table) -> void {
+    std::uint64_t total = 0;
+    for (std::int32_t i = 0; i < bins; ++i) total += counts[i];
+    std::uint64_t first = 0;
+    for (std::int32_t i = 0; i < bins && first == 0; ++i) first = counts[i];
+    if (total == first) {
+        for (std::int32_t i = 0; i < bins; ++i) table[i] = static_cast<float>(i) / static_cast<float>(bins - 1);
+        return;
+    }
+    std::uint64_t cdf = 0;
+    auto const range  = static_cast<double>(total - first);
+    for (std::int32_t i = 0; i < bins; ++i) {
+        cdf += counts[i];
+        table[i] = cdf <= first ? 0.0f : static_cast<float>(static_cast<double>(cdf - first) / range);
+    }
+}
+}
+
+histogram::histogram(std::int32_t const& channels, std::int32_t const& bins)
+    : m_bins(bins), m_channels(channels), m_counts(static_cast<std::size_t>(bins * channels), 0) {
+    if (bins < 2 || channels < 1) throw std::invalid_argument("nrv::histogram: needs at least 2 bins and 1 channel");
+}
+
+auto histogram::total(std::int32_t const& channel) const -> std::uint64_t {
+    std::uint64_t sum = 0;
+    auto const* c = counts(channel);
+    for (std::int32_t i = 0; i < m_bins; ++i) sum += c[i];
+    return sum;
+}
+
+auto histogram::merge(histogram const& other) -> void {
+    if (other.m_bins != m_bins || other.m_channels != m_channels)
+        throw std::invalid_argument("nrv::histogram::merge: histogram shapes differ");
+    for (std::size_t i = 0; i < m_counts.size(); ++i) m_counts[i] += other.m_counts[i];
+}
+
+auto compute_histogram(image const& source, std::int32_t const& bins) -> histogram {
+    auto const channels = source.channels();
+    return banded_histogram(source, channels, bins, [channels](float const* pixel, histogram& local) {
+        for (std::int32_t c = 0; c < channels; ++c) ++local.counts(c)[local.bin_of(pixel[c])];
+    });
+}
+
+auto compute_luminance_histogram(image const& source, std::int32_t const& bins) -> histogram {
+    auto const colour = source.channels() >= 3;
+    return banded_histogram(source, 1, bins, [colour](float const* pixel, histogram& local) {
+        auto const luma = colour ? 0.2126f * pixel[0] + 0.7152f * pixel[1] + 0.0722f * pixel[2] : pixel[0];
+        ++local.counts(0)[local.bin_of(luma)];
+    });
+}
+
+auto equalize(image const& source, image& destination) -> void {
+    auto const hist   = compute_histogram(source);
+    auto const colour = colour_channels(source.channels());
+    lut1d lut(hist.bins(), colour);
+    for (std::int32_t c = 0; c < colour; ++c) equalisation_table(hist.counts(c), hist.bins(), lut.table(c));
+    apply_lut(source, destination, lut);
+}
+
+auto auto_levels(image const& source, image& destination, float const& low, float const& high) -> void {
+    if (!(low >= 0.0f && low < high && high <= 1.0f))
+        throw std::invalid_argument("nrv::auto_levels: percentiles must satisfy 0 <= low < high <= 1");
+    // Finer bins than 8-bit so the stretch of float sources is not limited to 256 steps.
+    auto const hist   = compute_histogram(source, 1024);
+    auto const bins   = hist.bins();
+    auto const last   = static_cast<float>(bins - 1);
+    auto const colour = colour_channels(source.channels());
+    lut1d lut(bins, colour);
+    for (std::int32_t c = 0; c < colour; ++c) {
+        auto const* counts = hist.counts(c);
+        auto const total   = static_cast<double>(hist.total(c));
+        auto const low_count  = static_cast<double>(low) * total;
+        auto const high_count = static_cast<double>(high) * total;
+        std::int32_t black = 0, white = bins - 1;
+        double cdf = 0.0;
+        bool found_black = false;
+        for (std::int32_t i = 0; i < bins; ++i) {
+            cdf += static_cast<double>(counts[i]);
+            if (!found_black && cdf > low_count) {
+                black = i;
+                found_black = true;
+            }
+            if (cdf >= high_count) {
+                white = i;
+                break;
+            }
+        }
+        auto* table = lut.table(c);
+        if (white <= black) continue;  // Flat channel, leave the identity in place.
+        auto const b = static_cast<float>(black) / last;
+        auto const w = static_cast<float>(white) / last;
+        for (std::int32_t i = 0; i < bins; ++i)
+            table[i] = std::clamp((static_cast<float>(i) / last - b) / (w - b), 0.0f, 1.0f);
+    }
+    apply_lut(source, destination, lut);
+}
+
+auto clahe(image const& source, image& destination, std::int32_t const& tiles_x, std::int32_t const& tiles_y,
+           float const& clip_limit) -> void {
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::clahe: source and destination dimensions differ");
+    if (tiles_x < 1 || tiles_y < 1) throw std::invalid_argument("nrv::clahe: needs at least one tile");
+
+    constexpr std::int32_t bins = 256;
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+    auto const colour   = colour_channels(channels);
+    auto const columns  = std::min(tiles_x, std::max(width, 1));
+    auto const rows     = std::min(tiles_y, std::max(height, 1));
+    if (width == 0 || height == 0) return;
+
+    // One table per tile and colour channel, tile (i, j) covers [x0, x1) x [y0, y1).
+    auto const tile_x0 = [&](std::int32_t const& i) { return static_cast<std::int32_t>(std::int64_t{width} * i / columns); };
+    auto const tile_y0 = [&](std::int32_t const& j) { return static_cast<std::int32_t>(std::int64_t{height} * j / rows); };
+    std::vector<float> tables(static_cast<std::size_t>(columns * rows * colour * bins));
+    parallel_for(columns * rows, [&](std::int32_t const& index) {
+        auto const i  = index % columns;
+        auto const j  = index / columns;
+        auto const x0 = tile_x0(i), x1 = tile_x0(i + 1);
+        auto const y0 = tile_y0(j), y1 = tile_y0(j + 1);
+        histogram local(colour, bins);
+        for (auto y = y0; y < y1; ++y) {
+            auto const* row = source.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(width * channels);
+            for (auto x = x0; x < x1; ++x)
+                for (std::int32_t c = 0; c < colour; ++c) ++local.counts(c)[local.bin_of(row[x * channels + c])];
+        }
+        auto const pixels = static_cast<std::uint64_t>(x1 - x0) * static_cast<std::uint64_t>(y1 - y0);
+        auto const limit  = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(clip_limit * static_cast<float>(pixels) / bins));
+        for (std::int32_t c = 0; c < colour; ++c) {
+            auto* counts = local.counts(c);
+            // Clip and hand the excess back evenly, the remainder goes to evenly spaced bins.
+            std::uint64_t excess = 0;
+            for (std::int32_t b = 0; b < bins; ++b) {
+                if (counts[b] > limit) {
+                    excess += counts[b] - limit;
+                    counts[b] = limit;
+                }
+            }
+            auto const share     = excess / bins;
+            auto const remainder = static_cast<std::int32_t>(excess % bins);
+            for (std::int32_t b = 0; b < bins; ++b) counts[b] += share;
+            for (std::int32_t r = 0; r < remainder; ++r) ++counts[r * bins / std::max(remainder, 1)];
+
+            auto* table = tables.data() + static_cast<std::size_t>((index * colour + c) * bins);
+            std::uint64_t cdf = 0;
+            for (std::int32_t b = 0; b < bins; ++b) {
+                cdf += counts[b];
+                table[b] = static_cast<float>(static_cast<double>(cdf) / static_cast<double>(pixels));
+            }
+        }
+    });
+
+    // Blend the four nearest tile tables, positions are measured between tile centres.
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const ty = std::clamp((static_cast<float>(y) + 0.5f) * static_cast<float>(rows) / static_cast<float>(height) - 0.5f,
+                                       0.0f, static_cast<float>(rows - 1));
+            auto const j0 = std::min(static_cast<std::int32_t>(ty), rows - 1);
+            auto const j1 = std::min(j0 + 1, rows - 1);
+            auto const fy = ty - static_cast<float>(j0);
+            auto const offset = static_cast<std::size_t>(y) * static_cast<std::size_t>(width * channels);
+            auto const* in = source.buffer() + offset;
+            auto* out = destination.buffer() + offset;
+            for (std::int32_t x = 0; x < width; ++x) {
+                auto const tx = std::clamp((static_cast<float>(x) + 0.5f) * static_cast<float>(columns) / static_cast<float>(width) - 0.5f,
+                                           0.0f, static_cast<float>(columns - 1));
+                auto const i0 = std::min(static_cast<std::int32_t>(tx), columns - 1);
+                auto const i1 = std::min(i0 + 1, columns - 1);
+                auto const fx = tx - static_cast<float>(i0);
+                for (std::int32_t c = 0; c < colour; ++c) {
+                    auto const bin = std::clamp(static_cast<std::int32_t>(in[x * channels + c] * (bins - 1) + 0.5f), 0, bins - 1);
+                    auto const at  = [&](std::int32_t const& i, std::int32_t const& j) {
+                        return tables[static_cast<std::size_t>(((j * columns + i) * colour + c) * bins + bin)];
+                    };
+                    auto const top    = at(i0, j0) + (at(i1, j0) - at(i0, j0)) * fx;
+                    auto const bottom = at(i0, j1) + (at(i1, j1) - at(i0, j1)) * fx;
+                    out[x * channels + c] = top + (bottom - top) * fy;
+                }
+                for (auto c = colour; c < channels; ++c) out[x * channels + c] = in[x * channels + c];
+            }
+        }
+    });
+}
+}
@@ -0,0 +1,85 @@
+/**
+ * @file   histogram.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Histograms, histogram equalisation and CLAHE
+ *         https://en.wikipedia.org/wiki/Adaptive_histogram_equalization
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_HISTOGRAM_HPP
+#define IMAGEPP_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Counts per bin for one or more channels, bin i collects the values nearest to i / (bins - 1).
+ */
+class histogram {
+  public:
+    histogram(std::int32_t const& channels, std::int32_t const& bins = 256);
+
+    auto bins()     const -> std::int32_t { return m_bins; }
+    auto channels() const -> std::int32_t { return m_channels; }
+    auto counts(std::int32_t const& channel) -> std::uint64_t* { return m_counts.data() + channel * m_bins; }
+    auto counts(std::int32_t const& channel) const -> std::uint64_t const* { return m_counts.data() + channel * m_bins; }
+    auto total(std::int32_t const& channel) const -> std::uint64_t;
+
+    auto bin_of(float const& value) const -> std::int32_t {
+        return std::clamp(static_cast<std::int32_t>(value * static_cast<float>(m_bins - 1) + 0.5f), 0, m_bins - 1);
+    }
+    auto merge(histogram const& other) -> void;
+
+  private:
+    std::int32_t               m_bins;
+    std::int32_t               m_channels;
+    std::vector<std::uint64_t> m_counts;
+};
+
+/**
+ * Histogram of every channel. Row bands count into private histograms that are merged at the end,
+ * so the hot loop has no shared writes.
+ */
+auto compute_histogram(image const& source, std::int32_t const& bins = 256) -> histogram;
+
+/**
+ * Single channel histogram of Rec.709 luminance, or of the first channel for greyscale images.
+ */
+auto compute_luminance_histogram(image const& source, std::int32_t const& bins = 256) -> histogram;
+
+/**
+ * Global histogram equalisation of every colour channel through one lookup table pass.
+ */
+auto equalize(image const& source, image& destination) -> void;
+
+/**
+ * Stretch every colour channel so its low and high percentiles land on 0 and 1. Percentiles come from one
+ * histogram pass and the stretch is one lookup table pass, so a few hot pixels cannot flatten the contrast
+ * the way dividing by the maximum does.
+ * @param source      Image to stretch.
+ * @param destination Output, same dimensions as source, may be the source itself.
+ * @param low         Fraction of pixels clipped to black.
+ * @param high        Fraction of pixels at or below the white point.
+ */
+auto auto_levels(image const& source, image& destination, float const& low = 0.005f, float const& high = 0.995f) -> void;
+
+/**
+ * Contrast limited adaptive histogram equalisation. Every tile gets its own clipped equalisation table
+ * and pixels blend the tables of the four nearest tile centres bilinearly. Colour channels are processed
+ * on their own, convert to greyscale first to keep hues.
+ * @param source      Image to process.
+ * @param destination Output, same dimensions as source, may be the source itself.
+ * @param tiles_x     Tile columns.
+ * @param tiles_y     Tile rows.
+ * @param clip_limit  Bin limit as a multiple of the mean bin count, lower limits amplify noise less.
+ */
+auto clahe(image const& source, image& destination, std::int32_t const& tiles_x = 8, std::int32_t const& tiles_y = 8,
+           float const& clip_limit = 2.0f) -> void;
+}
+
+#endif  // IMAGEPP_HISTOGRAM_HPP
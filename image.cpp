@@ -9,30 +9,152 @@
 #include "image.hpp"
 
 #include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "stb_image.h"
-#include "stb_image_write.h"
+
+#include "png.hpp"
+#include "qoi.hpp"
+#include "raw.hpp"
 
 namespace nrv {
-image::image(std::filesystem::path const& filename) : m_filename(filename) {
+namespace {
+using stbi_ptr = std::unique_ptr<stbi_uc, decltype(&stbi_image_free)>;
+
+// Decode to 8-bit with the channel count converted by stb_image, 0 keeps the channels of the file.
+auto decode(char const* function, std::filesystem::path const& filename, std::int32_t const& channels,
+            std::int32_t& width, std::int32_t& height, std::int32_t& file_channels) -> stbi_ptr {
     using namespace std::string_literals;
-    auto data = stbi_load(m_filename.string().c_str(), &m_width, &m_height, &m_channels, 0);
+    stbi_ptr data{stbi_load(filename.string().c_str(), &width, &height, &file_channels, channels), stbi_image_free};
     if (data == nullptr)
-        throw std::runtime_error("nrv::image: error reading file: \""s + filename.string() + "\""s);
+        throw std::runtime_error(function + ": error reading file: \""s + filename.string() + "\""s);
+    return data;
+}
+
+// Float conversion through a table, a single pass from the decoder output into the destination.
+auto to_float(stbi_uc const* data, std::size_t const& size, float* destination) -> void {
+    static auto const table = [] {
+        std::array<float, 256> values{};
+        for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<float>(i) / 255.0f;
+        return values;
+    }();
+    std::transform(data, data + size, destination, [](auto const& pixel) { return table[pixel]; });
+}
+
+// Destinations of load_into must match the file size and have 1 to 4 channels.
+auto check_destination(char const* function, std::filesystem::path const& filename, std::int32_t const& width, std::int32_t const& height,
+                       std::int32_t const& channels, std::int32_t const& file_width, std::int32_t const& file_height) -> void {
+    using namespace std::string_literals;
+    if (channels < 1 || channels > 4)
+        throw std::invalid_argument(function + ": destination must have 1 to 4 channels"s);
+    if (file_width != width || file_height != height)
+        throw std::invalid_argument(function + ": destination is "s + std::to_string(width) + "x" + std::to_string(height) +
+                                    " but \"" + filename.string() + "\" is " + std::to_string(file_width) + "x" + std::to_string(file_height));
+}
+
+// Decode straight into a destination of fixed size, the dimensions of the decoded data are checked before copying.
+auto decode_into(char const* function, std::filesystem::path const& filename, std::int32_t const& width,
+                 std::int32_t const& height, std::int32_t const& channels) -> stbi_ptr {
+    using namespace std::string_literals;
+    if (channels < 1 || channels > 4)
+        throw std::invalid_argument(function + ": destination must have 1 to 4 channels"s);
+    std::int32_t file_width = 0, file_height = 0, file_channels = 0;
+    auto data = decode(function, filename, channels, file_width, file_height, file_channels);
+    check_destination(function, filename, width, height, channels, file_width, file_height);
+    return data;
+}
+
+// Up to limit bytes from the start of the file, the whole file by default.
+auto read_bytes(char const* function, std::filesystem::path const& filename,
+                std::size_t const& limit = std::numeric_limits<std::size_t>::max()) -> std::vector<std::uint8_t> {
+    using namespace std::string_literals;
+    std::ifstream file{filename, std::ios::binary};
+    if (!file) throw std::runtime_error(function + ": error reading file: \""s + filename.string() + "\""s);
+    std::vector<std::uint8_t> data(std::min(limit, static_cast<std::size_t>(std::filesystem::file_size(filename))));
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    data.resize(static_cast<std::size_t>(file.gcount()));
+    return data;
+}
+
+// Stream the rows of a QOI file into a destination of fixed size, row_fn receives the decoder and the row index.
+template <typename row_fn_t>
+auto decode_qoi_into(char const* function, std::filesystem::path const& filename, std::int32_t const& width,
+                     std::int32_t const& height, std::int32_t const& channels, row_fn_t const& row_fn) -> void {
+    auto const data = read_bytes(function, filename);
+    qoi_decoder decoder{data.data(), data.size()};
+    check_destination(function, filename, width, height, channels, decoder.width(), decoder.height());
+    for (std::int32_t y = 0; y < height; ++y) row_fn(decoder, y);
+}
+
+// Map a .nrv file, its channels are used as they are so the destination must have the same count.
+auto map_raw_into(char const* function, std::filesystem::path const& filename, std::int32_t const& width,
+                  std::int32_t const& height, std::int32_t const& channels) -> mapped_image {
+    using namespace std::string_literals;
+    mapped_image mapped{filename, true};
+    check_destination(function, filename, width, height, channels, mapped.width(), mapped.height());
+    if (mapped.channels() != channels)
+        throw std::invalid_argument(function + ": destination has "s + std::to_string(channels) + " channels but \"" +
+                                    filename.string() + "\" has " + std::to_string(mapped.channels()));
+    return mapped;
+}
+
+auto to_u8(float const& value) -> std::uint8_t {
+    return static_cast<std::uint8_t>(std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f));
+}
+}
+
+image::image(std::filesystem::path const& filename) : m_filename(filename), m_buffer(nullptr) {
+    if (filename.extension() == ".qoi") {
+        *this = read_qoi(filename);
+        m_filename = filename;
+        return;
+    }
+    if (filename.extension() == ".nrv") {
+        *this = read_raw(filename);
+        m_filename = filename;
+        return;
+    }
+    std::int32_t file_channels = 0;
+    auto const data = decode("nrv::image", filename, 0, m_width, m_height, file_channels);
+    m_channels = file_channels;
     m_size = static_cast<std::size_t>(m_width * m_height * m_channels);
     m_buffer = new float[m_size];
-    std::transform(data, data + m_size, m_buffer, [](auto const& pixel) {
-        return static_cast<float>(pixel) / 255.0f;
-    });
-    stbi_image_free(data);
+    to_float(data.get(), m_size, m_buffer);
 }
 image::image(std::int32_t const& size) : image(size, size) {}
 image::image(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels)
     : m_width(width), m_height(height), m_channels(channels)
     , m_size(static_cast<std::size_t>(m_width * m_height * m_channels))
     , m_buffer(new float[m_size]) {}
+image::image(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels, float* buffer)
+    : m_width(width), m_height(height), m_channels(channels)
+    , m_size(static_cast<std::size_t>(m_width * m_height * m_channels))
+    , m_buffer(buffer), m_owner(false) {}
+image::image(image&& other) noexcept
+    : m_filename(std::move(other.m_filename))
+    , m_width(std::exchange(other.m_width, 0)), m_height(std::exchange(other.m_height, 0))
+    , m_channels(std::exchange(other.m_channels, 0)), m_size(std::exchange(other.m_size, 0))
+    , m_buffer(std::exchange(other.m_buffer, nullptr)), m_owner(std::exchange(other.m_owner, true)) {}
 image::~image() {
-    delete[] m_buffer;
+    if (m_owner) delete[] m_buffer;
+}
+auto image::operator=(image&& other) noexcept -> image& {
+    if (this == &other) return *this;
+    if (m_owner) delete[] m_buffer;
+    m_filename = std::move(other.m_filename);
+    m_width    = std::exchange(other.m_width, 0);
+    m_height   = std::exchange(other.m_height, 0);
+    m_channels = std::exchange(other.m_channels, 0);
+    m_size     = std::exchange(other.m_size, 0);
+    m_buffer   = std::exchange(other.m_buffer, nullptr);
+    m_owner    = std::exchange(other.m_owner, true);
+    return *this;
 }
 auto image::str()  const -> std::string {
     std::string str{"nrv::image{"};
@@ -45,13 +167,67 @@ auto image::str()  const -> std::string {
     return str;
 }
 
+auto read_info(std::filesystem::path const& filename) -> image_info {
+    using namespace std::string_literals;
+    if (filename.extension() == ".qoi") {
+        // The decoder wants room for the 14 byte header and the 8 byte end marker, the pixels are not read.
+        auto const data = read_bytes("nrv::read_info", filename, 14 + 8);
+        qoi_decoder const decoder{data.data(), data.size()};
+        return {decoder.width(), decoder.height(), decoder.channels()};
+    }
+    if (filename.extension() == ".nrv") {
+        auto const header = read_raw_header(filename);
+        return {header.width, header.height, header.channels};
+    }
+    image_info info{};
+    if (stbi_info(filename.string().c_str(), &info.width, &info.height, &info.channels) == 0)
+        throw std::runtime_error("nrv::read_info: error reading file: \""s + filename.string() + "\""s);
+    return info;
+}
+
+auto load_into(std::filesystem::path const& filename, image& destination) -> void {
+    auto const width    = destination.width();
+    auto const height   = destination.height();
+    auto const channels = destination.channels();
+    if (filename.extension() == ".qoi") {
+        auto const stride = static_cast<std::size_t>(width) * static_cast<std::size_t>(channels);
+        decode_qoi_into("nrv::load_into", filename, width, height, channels, [&](qoi_decoder& decoder, std::int32_t const& y) {
+            decoder.read_row(destination.buffer() + static_cast<std::size_t>(y) * stride, channels);
+        });
+        return;
+    }
+    if (filename.extension() == ".nrv") {
+        auto const mapped = map_raw_into("nrv::load_into", filename, width, height, channels);
+        std::copy_n(mapped.buffer(), destination.size(), destination.buffer());
+        return;
+    }
+    auto const data = decode_into("nrv::load_into", filename, width, height, channels);
+    to_float(data.get(), destination.size(), destination.buffer());
+}
+
+auto load_into(std::filesystem::path const& filename, std::uint8_t* destination, std::int32_t const& width,
+               std::int32_t const& height, std::int32_t const& channels) -> void {
+    auto const size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * static_cast<std::size_t>(channels);
+    if (filename.extension() == ".qoi") {
+        auto const stride = static_cast<std::size_t>(width) * static_cast<std::size_t>(channels);
+        std::vector<float> row(stride);
+        decode_qoi_into("nrv::load_into", filename, width, height, channels, [&](qoi_decoder& decoder, std::int32_t const& y) {
+            decoder.read_row(row.data(), channels);
+            std::transform(row.begin(), row.end(), destination + static_cast<std::size_t>(y) * stride, to_u8);
+        });
+        return;
+    }
+    if (filename.extension() == ".nrv") {
+        auto const mapped = map_raw_into("nrv::load_into", filename, width, height, channels);
+        std::transform(mapped.buffer(), mapped.buffer() + size, destination, to_u8);
+        return;
+    }
+    auto const data = decode_into("nrv::load_into", filename, width, height, channels);
+    std::copy_n(data.get(), size, destination);
+}
+
 auto write_png(std::string const& filename, image const& img) -> void {
-    auto data = new std::uint8_t[img.size()];
-    std::transform(img.buffer(), img.buffer() + img.size(), data, [](auto const& pixel) {
-        return std::uint8_t(std::clamp(pixel * 255.0f, 0.0f, 255.0f));
-    });
-    stbi_write_png(filename.c_str(), img.width(), img.height(), img.channels(), data, img.width() * img.channels());
-    delete[] data;
+    write_png(filename, img, png_options{});
 }
 
 auto render_img(image& img, render_fn_t const& fn) -> void {
@@ -21,16 +21,30 @@
 namespace nrv {
 class image {
   public:
+    /**
+     * Load an image file, QOI and native files by their .qoi and .nrv extensions and everything else through
+     * stb_image. See nrv::mapped_image to use a .nrv file without copying.
+     */
     image(std::filesystem::path const& filename);
     image(std::int32_t const& size);
     image(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels = 3);
+    /**
+     * Wrap an existing buffer of width * height * channels floats without taking ownership.
+     */
+    image(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels, float* buffer);
+    image(image const&) = delete;
+    image(image&& other) noexcept;
     ~image();
 
+    auto operator=(image const&) -> image& = delete;
+    auto operator=(image&& other) noexcept -> image&;
+
     auto width()    const -> std::int32_t { return m_width; }
     auto height()   const -> std::int32_t { return m_height; }
     auto channels() const -> std::int32_t { return m_channels; }
     auto size()     const -> std::size_t  { return m_size; }
     auto buffer()   const -> float*       { return m_buffer; }
+    auto is_view()  const -> bool         { return !m_owner; }
     auto str()      const -> std::string;
 
   public:
@@ -38,6 +52,7 @@ class image {
         if (x < 0 || x > m_width - 1 || y < 0 || y > m_height - 1) return;
         auto const index = (y * m_channels) * m_width + (x * m_channels);
         m_buffer[index + 0] = color.r;
+        if (m_channels < 3) return;
         m_buffer[index + 1] = color.g;
         m_buffer[index + 2] = color.b;
     }
@@ -45,12 +60,13 @@ class image {
         if (x < 0 || x > m_width - 1 || y < 0 || y > m_height - 1) return;
         set_pixel(x, y, {color.r, color.g, color.b});
         auto const index = (y * m_channels) * m_width + (x * m_channels);
-        if (m_channels == 4) m_buffer[index + 3] = color.a;
+        if (m_channels == 2 || m_channels == 4) m_buffer[index + m_channels - 1] = color.a;
     }
 
     auto get_pixel_rgb(std::int32_t const& x, std::int32_t const& y) const -> glm::vec3 {
         if (x < 0 || x > m_width - 1 || y < 0 || y > m_height - 1) return {0.0f, 0.0f, 0.0f};
         auto const index = (y * m_channels) * m_width + (x * m_channels);
+        if (m_channels < 3) return glm::vec3{m_buffer[index]};
         return {
             m_buffer[index + 0],
             m_buffer[index + 1],
@@ -60,7 +76,8 @@ class image {
     auto get_pixel_rgba(std::int32_t const& x, std::int32_t const& y) const -> glm::vec4 {
         if (x < 0 || x > m_width - 1 || y < 0 || y > m_height - 1) return {0.0f, 0.0f, 0.0f, 0.0f};
         auto const index = (y * m_channels) * m_width + (x * m_channels);
-        auto alpha = m_channels == 4 ? m_buffer[index + 3] : 1.0f;
+        auto alpha = m_channels == 2 || m_channels == 4 ? m_buffer[index + m_channels - 1] : 1.0f;
+        if (m_channels < 3) return {glm::vec3{m_buffer[index]}, alpha};
         return {
             m_buffer[index + 0],
             m_buffer[index + 1],
@@ -90,6 +107,9 @@ class image {
             }
         }
     }
+    /**
+     * Divide by the maximum, see nrv::auto_levels for a stretch that ignores outliers.
+     */
     auto normalise() -> void {
         auto max = *std::max_element(m_buffer, m_buffer + m_size);
         std::transform(m_buffer, m_buffer + m_size, m_buffer, [&max](auto const& value) {
@@ -104,8 +124,49 @@ class image {
     std::int32_t m_channels;
     std::size_t  m_size;
     float*       m_buffer;
+    bool         m_owner{true};
+};
+
+/**
+ * Number of colour channels, the last channel of 2 and 4 channel images is alpha.
+ */
+constexpr auto colour_channels(std::int32_t const& channels) -> std::int32_t {
+    return channels == 2 || channels == 4 ? channels - 1 : channels;
+}
+
+/**
+ * Dimensions and channel count stored in an image file.
+ */
+struct image_info {
+    std::int32_t width;
+    std::int32_t height;
+    std::int32_t channels;
 };
 
+/**
+ * Read the header of an image file without decoding the pixels, QOI and native files by their .qoi and
+ * .nrv extensions and everything else through stb_image.
+ */
+auto read_info(std::filesystem::path const& filename) -> image_info;
+
+/**
+ * Decode an image file into memory owned by the caller, for example a view over a pooled or mapped buffer.
+ * The file is converted to the destination channel count by the decoder and to float in a single pass,
+ * so no intermediate float image is allocated. QOI rows are streamed into the destination and .nrv
+ * files are copied from a mapping, their channel count must match the destination.
+ * @param filename    Image file, .qoi, .nrv or any type stb_image supports.
+ * @param destination Image with the file's width and height and 1 to 4 channels.
+ */
+auto load_into(std::filesystem::path const& filename, image& destination) -> void;
+
+/**
+ * Decode an image file into 8-bit pixels owned by the caller, files are handled as in the float overload
+ * and .nrv samples are rounded to 8 bits.
+ * @param destination width * height * channels bytes, rows are packed.
+ */
+auto load_into(std::filesystem::path const& filename, std::uint8_t* destination, std::int32_t const& width,
+               std::int32_t const& height, std::int32_t const& channels) -> void;
+
 /**
  * Convert to 8-bit pixel data and save as PNG file
  * @param filename Location to store the image file.
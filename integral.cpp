@@ -0,0 +1,61 @@
+/**
+ * @file   integral.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Summed-area tables
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "integral.hpp"
+
+#include <algorithm>
+
+#include "parallel.hpp"
+
+namespace nrv {
+integral_image::integral_image(image const& source)
+    : m_width(source.width()), m_height(source.height()), m_channels(source.channels())
+    , m_table(static_cast<std::size_t>(m_width + 1) * static_cast<std::size_t>(m_height + 1) * static_cast<std::size_t>(m_channels), 0.0) {
+    auto const stride = (m_width + 1) * m_channels;
+
+    // Running sums along every row in parallel.
+    parallel_for_range(m_height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const* in = source.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width * m_channels);
+            auto* out = m_table.data() + static_cast<std::size_t>(y + 1) * static_cast<std::size_t>(stride) + m_channels;
+            for (std::int32_t c = 0; c < m_channels; ++c) out[c] = in[c];
+            for (auto i = m_channels; i < m_width * m_channels; ++i) out[i] = out[i - m_channels] + in[i];
+        }
+    });
+
+    // Running sums down the columns, strips of a row are added at once so the inner loop is contiguous.
+    constexpr std::int32_t strip = 1024;
+    auto const strips = (stride + strip - 1) / strip;
+    parallel_for(strips, [&](std::int32_t const& index) {
+        auto const first = index * strip;
+        auto const count = std::min(strip, stride - first);
+        for (std::int32_t y = 2; y <= m_height; ++y) {
+            auto* row = m_table.data() + static_cast<std::size_t>(y) * static_cast<std::size_t>(stride) + first;
+            auto const* above = row - stride;
+            for (std::int32_t i = 0; i < count; ++i) row[i] += above[i];
+        }
+    });
+}
+
+auto integral_image::sum(std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1, double* out) const -> std::int32_t {
+    x0 = std::clamp(x0, 0, m_width);
+    x1 = std::clamp(x1, 0, m_width);
+    y0 = std::clamp(y0, 0, m_height);
+    y1 = std::clamp(y1, 0, m_height);
+    if (x1 <= x0 || y1 <= y0) {
+        std::fill_n(out, m_channels, 0.0);
+        return 0;
+    }
+    auto const* a = at(x0, y0);
+    auto const* b = at(x1, y0);
+    auto const* c = at(x0, y1);
+    auto const* d = at(x1, y1);
+    for (std::int32_t i = 0; i < m_channels; ++i) out[i] = d[i] - b[i] - c[i] + a[i];
+    return (x1 - x0) * (y1 - y0);
+}
+}
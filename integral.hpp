@@ -0,0 +1,60 @@
+/**
+ * @file   integral.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Summed-area tables
+ *         https://en.wikipedia.org/wiki/Summed-area_table
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_INTEGRAL_HPP
+#define IMAGEPP_INTEGRAL_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Summed-area table with a zero first row and column, every channel of the source is summed on its own.
+ * Sums are kept in double so sums of squares over large images stay exact enough for variances.
+ */
+class integral_image {
+  public:
+    integral_image(image const& source);
+
+    auto width()    const -> std::int32_t { return m_width; }
+    auto height()   const -> std::int32_t { return m_height; }
+    auto channels() const -> std::int32_t { return m_channels; }
+
+    /**
+     * Sum every channel over [x0, x1) x [y0, y1), the rectangle is clipped to the image.
+     * @param out Receives channels() sums.
+     * @return Number of pixels inside the clipped rectangle.
+     */
+    auto sum(std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1, double* out) const -> std::int32_t;
+
+    /**
+     * Sum of one channel over [x0, x1) x [y0, y1), the rectangle must lie inside the image.
+     */
+    auto sum(std::int32_t const& x0, std::int32_t const& y0, std::int32_t const& x1, std::int32_t const& y1,
+             std::int32_t const& channel) const -> double {
+        return at(x1, y1)[channel] - at(x0, y1)[channel] - at(x1, y0)[channel] + at(x0, y0)[channel];
+    }
+
+  private:
+    auto at(std::int32_t const& x, std::int32_t const& y) const -> double const* {
+        return m_table.data() + (static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width + 1)
+                               + static_cast<std::size_t>(x)) * static_cast<std::size_t>(m_channels);
+    }
+
+  private:
+    std::int32_t        m_width;
+    std::int32_t        m_height;
+    std::int32_t        m_channels;
+    std::vector<double> m_table;
+};
+}
+
+#endif  // IMAGEPP_INTEGRAL_HPP
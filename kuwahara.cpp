@@ -0,0 +1,77 @@
+/**
+ * @file   kuwahara.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Kuwahara painterly filter
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "kuwahara.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "integral.hpp"
+#include "parallel.hpp"
+
+namespace nrv {
+auto kuwahara_filter(image const& source, image& destination, std::int32_t const& radius) -> void {
+    if (radius < 0) throw std::invalid_argument("nrv::kuwahara_filter: radius must not be negative");
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::kuwahara_filter: source and destination dimensions differ");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+
+    // Colour channels plus luminance and squared luminance, one table answers every quadrant query.
+    auto const packed = channels + 2;
+    image moments{width, height, packed};
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto p = static_cast<std::size_t>(begin) * static_cast<std::size_t>(width); p < static_cast<std::size_t>(end) * static_cast<std::size_t>(width); ++p) {
+            auto const* in = source.buffer() + p * static_cast<std::size_t>(channels);
+            auto* m = moments.buffer() + p * static_cast<std::size_t>(packed);
+            auto const luma = channels >= 3 ? 0.2126f * in[0] + 0.7152f * in[1] + 0.0722f * in[2] : in[0];
+            for (std::int32_t c = 0; c < channels; ++c) m[c] = in[c];
+            m[channels + 0] = luma;
+            m[channels + 1] = luma * luma;
+        }
+    });
+    integral_image const table{moments};
+
+    parallel_for_range(height, 8, [&](std::int32_t const& begin, std::int32_t const& end) {
+        std::vector<double> sums(static_cast<std::size_t>(packed));
+        std::vector<double> best(static_cast<std::size_t>(packed));
+        for (auto y = begin; y < end; ++y) {
+            auto* out = destination.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(width * channels);
+            for (std::int32_t x = 0; x < width; ++x) {
+                auto best_variance = std::numeric_limits<double>::max();
+                auto best_count    = 1;
+                for (std::int32_t q = 0; q < 4; ++q) {
+                    auto const x0 = q & 1 ? x : x - radius;
+                    auto const y0 = q & 2 ? y : y - radius;
+                    auto const count = table.sum(x0, y0, x0 + radius + 1, y0 + radius + 1, sums.data());
+                    auto const n        = static_cast<double>(count);
+                    auto const mean     = sums[static_cast<std::size_t>(channels)] / n;
+                    auto const variance = sums[static_cast<std::size_t>(channels + 1)] / n - mean * mean;
+                    if (variance < best_variance) {
+                        best_variance = variance;
+                        best_count    = count;
+                        best.swap(sums);
+                    }
+                }
+                for (std::int32_t c = 0; c < channels; ++c)
+                    out[x * channels + c] = static_cast<float>(best[static_cast<std::size_t>(c)] / static_cast<double>(best_count));
+            }
+        }
+    });
+}
+
+auto kuwahara_filter(image const& source, std::int32_t const& radius) -> image {
+    image output{source.width(), source.height(), source.channels()};
+    kuwahara_filter(source, output, radius);
+    return output;
+}
+}
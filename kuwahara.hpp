@@ -0,0 +1,30 @@
+/**
+ * @file   kuwahara.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Kuwahara painterly filter
+ *         https://en.wikipedia.org/wiki/Kuwahara_filter
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_KUWAHARA_HPP
+#define IMAGEPP_KUWAHARA_HPP
+
+#include <cstdint>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Every pixel takes the mean colour of whichever of its four (radius + 1)^2 quadrants has the lowest
+ * luminance variance. Means and variances come from summed-area tables, so the cost per pixel does not
+ * depend on the radius.
+ * @param source      Image to filter.
+ * @param destination Filtered output, same dimensions as source.
+ * @param radius      Quadrant size minus one in pixels.
+ */
+auto kuwahara_filter(image const& source, image& destination, std::int32_t const& radius) -> void;
+auto kuwahara_filter(image const& source, std::int32_t const& radius) -> image;
+}
+
+#endif  // IMAGEPP_KUWAHARA_HPP
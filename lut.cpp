@@ -0,0 +1,260 @@
+/**
+ * @file   lut.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  1D lookup tables and 3D colour lookup tables
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "lut.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "parallel.hpp"
+
+namespace nrv {
+lut1d::lut1d(std::int32_t const& size, std::int32_t const& channels)
+    : m_size(size), m_channels(channels), m_table(static_cast<std::size_t>(size * channels)) {
+    if (size < 2 || channels < 1) throw std::invalid_argument("nrv::lut1d: needs at least 2 entries and 1 channel");
+    for (std::int32_t c = 0; c < channels; ++c)
+        for (std::int32_t i = 0; i < size; ++i)
+            table(c)[i] = static_cast<float>(i) / static_cast<float>(size - 1);
+}
+
+auto apply_lut(image const& source, image& destination, lut1d const& lut) -> void {
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::apply_lut: source and destination dimensions differ");
+    auto const channels = source.channels();
+    auto const colour   = colour_channels(channels);
+    if (lut.channels() != 1 && lut.channels() != colour)
+        throw std::invalid_argument("nrv::apply_lut: table must have 1 channel or one per colour channel");
+
+    auto const width = source.width();
+    parallel_for_range(source.height(), 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const offset = static_cast<std::size_t>(y) * static_cast<std::size_t>(width * channels);
+            auto const* in = source.buffer() + offset;
+            auto* out = destination.buffer() + offset;
+            for (std::int32_t x = 0; x < width; ++x) {
+                for (std::int32_t c = 0; c < colour; ++c)
+                    out[x * channels + c] = lut(in[x * channels + c], lut.channels() == 1 ? 0 : c);
+                for (auto c = colour; c < channels; ++c)
+                    out[x * channels + c] = in[x * channels + c];
+            }
+        }
+    });
+}
+
+lut3d::lut3d(std::int32_t const& size)
+    : m_size(size), m_table(static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * 3) {
+    if (size < 2) throw std::invalid_argument("nrv::lut3d: needs at least 2 entries per axis");
+    auto const scale = 1.0f / static_cast<float>(size - 1);
+    for (std::int32_t b = 0; b < size; ++b)
+        for (std::int32_t g = 0; g < size; ++g)
+            for (std::int32_t r = 0; r < size; ++r) {
+                auto* e = entry(r, g, b);
+                e[0] = static_cast<float>(r) * scale;
+                e[1] = static_cast<float>(g) * scale;
+                e[2] = static_cast<float>(b) * scale;
+            }
+}
+
+auto lut3d::set_domain(glm::vec3 const& min, glm::vec3 const& max) -> void {
+    if (!(max.r > min.r && max.g > min.g && max.b > min.b))
+        throw std::invalid_argument("nrv::lut3d::set_domain: domain maximum must exceed the minimum");
+    m_min = min;
+    m_max = max;
+}
+
+auto lut3d::sample(glm::vec3 const& colour) const -> glm::vec3 {
+    auto const last = static_cast<float>(m_size - 1);
+    auto const p = glm::clamp((colour - m_min) / (m_max - m_min), 0.0f, 1.0f) * last;
+    auto const r = std::min(static_cast<std::int32_t>(p.r), m_size - 2);
+    auto const g = std::min(static_cast<std::int32_t>(p.g), m_size - 2);
+    auto const b = std::min(static_cast<std::int32_t>(p.b), m_size - 2);
+    auto const fr = p.r - static_cast<float>(r);
+    auto const fg = p.g - static_cast<float>(g);
+    auto const fb = p.b - static_cast<float>(b);
+
+    auto const dr = std::size_t{3};
+    auto const dg = static_cast<std::size_t>(m_size) * 3;
+    auto const db = dg * static_cast<std::size_t>(m_size);
+    auto const* c000 = m_table.data() + static_cast<std::size_t>(b) * db + static_cast<std::size_t>(g) * dg + static_cast<std::size_t>(r) * dr;
+    auto const* c111 = c000 + dr + dg + db;
+
+    // Pick the tetrahedron from the order of the fractions, it is spanned by c000, c111 and two cell corners.
+    float const* c1;
+    float const* c2;
+    float w0, w1, w2, w3;
+    if (fr > fg) {
+        if (fg > fb)      { c1 = c000 + dr; c2 = c000 + dr + dg; w0 = 1.0f - fr; w1 = fr - fg; w2 = fg - fb; w3 = fb; }
+        else if (fr > fb) { c1 = c000 + dr; c2 = c000 + dr + db; w0 = 1.0f - fr; w1 = fr - fb; w2 = fb - fg; w3 = fg; }
+        else              { c1 = c000 + db; c2 = c000 + dr + db; w0 = 1.0f - fb; w1 = fb - fr; w2 = fr - fg; w3 = fg; }
+    } else {
+        if (fb > fg)      { c1 = c000 + db; c2 = c000 + dg + db; w0 = 1.0f - fb; w1 = fb - fg; w2 = fg - fr; w3 = fr; }
+        else if (fb > fr) { c1 = c000 + dg; c2 = c000 + dg + db; w0 = 1.0f - fg; w1 = fg - fb; w2 = fb - fr; w3 = fr; }
+        else              { c1 = c000 + dg; c2 = c000 + dr + dg; w0 = 1.0f - fg; w1 = fg - fr; w2 = fr - fb; w3 = fb; }
+    }
+    return {
+        w0 * c000[0] + w1 * c1[0] + w2 * c2[0] + w3 * c111[0],
+        w0 * c000[1] + w1 * c1[1] + w2 * c2[1] + w3 * c111[1],
+        w0 * c000[2] + w1 * c1[2] + w2 * c2[2] + w3 * c111[2],
+    };
+}
+
+auto lut3d::sample(float const* source, float* destination, std::size_t const& count, std::int32_t const& channels) const -> void {
+    // Blocks of pixels in two passes. The first finds cells, corner offsets and weights without branches so it
+    // vectorises, the tetrahedron is spanned by c000, c111, the corner along the largest fraction and the
+    // corner opposite the smallest. The second pass gathers the four corners.
+    constexpr std::size_t block = 64;
+    auto const last  = static_cast<float>(m_size - 1);
+    auto const top   = m_size - 2;
+    auto const scale = glm::vec3{last} / (m_max - m_min);
+    auto const dr = std::uint32_t{3};
+    auto const dg = static_cast<std::uint32_t>(m_size) * 3;
+    auto const db = dg * static_cast<std::uint32_t>(m_size);
+    auto const stride = static_cast<std::size_t>(channels);
+
+    std::array<float, block> red, green, blue;
+    std::array<std::uint32_t, block> base, first, second;
+    std::array<float, block> w0, w1, w2, w3;
+    for (std::size_t start = 0; start < count; start += block) {
+        auto const n = std::min(block, count - start);
+        auto const* in = source + start * stride;
+        // Planar copies, the interleaved loads would keep the next loop scalar.
+        for (std::size_t i = 0; i < n; ++i) {
+            red[i]   = in[i * stride + 0];
+            green[i] = in[i * stride + 1];
+            blue[i]  = in[i * stride + 2];
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            auto const pr = std::clamp((red[i]   - m_min.r) * scale.r, 0.0f, last);
+            auto const pg = std::clamp((green[i] - m_min.g) * scale.g, 0.0f, last);
+            auto const pb = std::clamp((blue[i]  - m_min.b) * scale.b, 0.0f, last);
+            auto const r = std::min(static_cast<std::int32_t>(pr), top);
+            auto const g = std::min(static_cast<std::int32_t>(pg), top);
+            auto const b = std::min(static_cast<std::int32_t>(pb), top);
+            auto const fr = pr - static_cast<float>(r);
+            auto const fg = pg - static_cast<float>(g);
+            auto const fb = pb - static_cast<float>(b);
+            auto const hi  = std::max(fr, std::max(fg, fb));
+            auto const lo  = std::min(fr, std::min(fg, fb));
+            auto const mid = fr + fg + fb - hi - lo;
+            // Ties leave the ambiguous corner with zero weight, so any of the tied axes is correct.
+            auto const largest  = fr == hi ? dr : fg == hi ? dg : db;
+            auto const smallest = fb == lo ? db : fg == lo ? dg : dr;
+            base[i]   = static_cast<std::uint32_t>(b) * db + static_cast<std::uint32_t>(g) * dg + static_cast<std::uint32_t>(r) * dr;
+            first[i]  = largest;
+            second[i] = dr + dg + db - smallest;
+            w0[i] = 1.0f - hi;
+            w1[i] = hi - mid;
+            w2[i] = mid - lo;
+            w3[i] = lo;
+        }
+        auto* out = destination + start * stride;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto const* c000 = m_table.data() + base[i];
+            auto const* c1   = c000 + first[i];
+            auto const* c2   = c000 + second[i];
+            auto const* c111 = c000 + dr + dg + db;
+            for (std::size_t c = 0; c < 3; ++c)
+                out[i * stride + c] = w0[i] * c000[c] + w1[i] * c1[c] + w2[i] * c2[c] + w3[i] * c111[c];
+        }
+    }
+}
+
+auto load_cube(std::filesystem::path const& filename) -> lut3d {
+    using namespace std::string_literals;
+    std::ifstream file{filename};
+    if (!file) throw std::runtime_error("nrv::load_cube: error reading file: \""s + filename.string() + "\""s);
+
+    auto const fail = [&](std::string const& message) {
+        return std::runtime_error("nrv::load_cube: \""s + filename.string() + "\": "s + message);
+    };
+    // Parse three floats, returns false when the line holds anything else.
+    auto const read_vec3 = [](char const* text, glm::vec3& out) {
+        char* end = nullptr;
+        for (std::int32_t i = 0; i < 3; ++i) {
+            out[i] = std::strtof(text, &end);
+            if (end == text) return false;
+            text = end;
+        }
+        while (*text == ' ' || *text == '\t' || *text == '\r') ++text;
+        return *text == '\0';
+    };
+
+    std::int32_t size = 0;
+    glm::vec3 min{0.0f}, max{1.0f};
+    std::vector<float> entries;
+    std::string line;
+    while (std::getline(file, line)) {
+        auto const first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+        auto const* text = line.c_str() + first;
+        auto const keyword = [&](char const* name) { return line.compare(first, std::strlen(name), name) == 0; };
+        if (keyword("TITLE")) continue;
+        if (keyword("LUT_1D_SIZE")) throw fail("1D tables are not supported");
+        if (keyword("LUT_3D_SIZE")) {
+            size = std::atoi(text + std::strlen("LUT_3D_SIZE"));
+            if (size < 2 || size > 256) throw fail("invalid LUT_3D_SIZE");
+            entries.reserve(static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * 3);
+            continue;
+        }
+        if (keyword("DOMAIN_MIN")) {
+            if (!read_vec3(text + std::strlen("DOMAIN_MIN"), min)) throw fail("invalid DOMAIN_MIN");
+            continue;
+        }
+        if (keyword("DOMAIN_MAX")) {
+            if (!read_vec3(text + std::strlen("DOMAIN_MAX"), max)) throw fail("invalid DOMAIN_MAX");
+            continue;
+        }
+        if (keyword("LUT_3D_INPUT_RANGE")) {
+            glm::vec3 range{0.0f};
+            auto const ok = std::sscanf(text + std::strlen("LUT_3D_INPUT_RANGE"), "%f %f", &range[0], &range[1]) == 2;
+            if (!ok) throw fail("invalid LUT_3D_INPUT_RANGE");
+            min = glm::vec3{range[0]};
+            max = glm::vec3{range[1]};
+            continue;
+        }
+        glm::vec3 value{0.0f};
+        if (!read_vec3(text, value)) throw fail("unexpected line \"" + line + "\"");
+        if (size == 0) throw fail("table data before LUT_3D_SIZE");
+        entries.insert(entries.end(), {value.r, value.g, value.b});
+    }
+    if (size == 0) throw fail("missing LUT_3D_SIZE");
+    if (entries.size() != static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * static_cast<std::size_t>(size) * 3)
+        throw fail("expected " + std::to_string(size * size * size) + " entries");
+
+    lut3d lut{size};
+    lut.set_domain(min, max);
+    std::copy(entries.begin(), entries.end(), lut.buffer());
+    return lut;
+}
+
+auto apply_lut(image const& source, image& destination, lut3d const& lut) -> void {
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::apply_lut: source and destination dimensions differ");
+    if (source.channels() < 3) throw std::invalid_argument("nrv::apply_lut: colour cube needs at least three channels");
+
+    auto const width    = source.width();
+    auto const channels = source.channels();
+    parallel_for_range(source.height(), 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        auto const offset = static_cast<std::size_t>(begin) * static_cast<std::size_t>(width * channels);
+        auto const count  = static_cast<std::size_t>(end - begin) * static_cast<std::size_t>(width);
+        auto const* in = source.buffer() + offset;
+        auto* out = destination.buffer() + offset;
+        lut.sample(in, out, count, channels);
+        if (channels == 4 && in != out)
+            for (std::size_t p = 0; p < count; ++p) out[p * 4 + 3] = in[p * 4 + 3];
+    });
+}
+}
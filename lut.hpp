@@ -0,0 +1,115 @@
+/**
+ * @file   lut.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  1D lookup tables and 3D colour lookup tables
+ *         https://en.wikipedia.org/wiki/3D_lookup_table
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_LUT_HPP
+#define IMAGEPP_LUT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Lookup table over [0, 1] with entry i at i / (size - 1), read with linear interpolation.
+ * A table with one channel applies to every colour channel, otherwise channel c uses table c.
+ */
+class lut1d {
+  public:
+    /**
+     * Identity table.
+     */
+    lut1d(std::int32_t const& size = 256, std::int32_t const& channels = 1);
+
+    auto size()     const -> std::int32_t { return m_size; }
+    auto channels() const -> std::int32_t { return m_channels; }
+    auto table(std::int32_t const& channel) -> float* { return m_table.data() + channel * m_size; }
+    auto table(std::int32_t const& channel) const -> float const* { return m_table.data() + channel * m_size; }
+
+    auto operator()(float const& value, std::int32_t const& channel = 0) const -> float {
+        auto const* t = table(channel);
+        auto const x  = std::clamp(value, 0.0f, 1.0f) * static_cast<float>(m_size - 1);
+        auto const i  = std::min(static_cast<std::int32_t>(x), m_size - 2);
+        auto const f  = x - static_cast<float>(i);
+        return t[i] + (t[i + 1] - t[i]) * f;
+    }
+
+  private:
+    std::int32_t       m_size;
+    std::int32_t       m_channels;
+    std::vector<float> m_table;
+};
+
+/**
+ * Map every colour channel of source through the table in parallel row bands, alpha is copied as is.
+ * @param source      Image to map.
+ * @param destination Output, same dimensions as source, may be the source itself.
+ * @param lut         Table with one channel or one per colour channel.
+ */
+auto apply_lut(image const& source, image& destination, lut1d const& lut) -> void;
+
+/**
+ * Colour cube of size^3 RGB entries, packed with red varying fastest like the .cube format,
+ * so neighbouring red samples share cache lines. Inputs are mapped from the domain onto the cube.
+ */
+class lut3d {
+  public:
+    /**
+     * Identity cube.
+     */
+    lut3d(std::int32_t const& size = 33);
+
+    auto size()   const -> std::int32_t { return m_size; }
+    auto buffer() -> float* { return m_table.data(); }
+    auto buffer() const -> float const* { return m_table.data(); }
+    auto domain_min() const -> glm::vec3 { return m_min; }
+    auto domain_max() const -> glm::vec3 { return m_max; }
+    auto set_domain(glm::vec3 const& min, glm::vec3 const& max) -> void;
+
+    auto entry(std::int32_t const& r, std::int32_t const& g, std::int32_t const& b) -> float* {
+        return m_table.data() + ((static_cast<std::size_t>(b) * static_cast<std::size_t>(m_size) + static_cast<std::size_t>(g))
+                                 * static_cast<std::size_t>(m_size) + static_cast<std::size_t>(r)) * 3;
+    }
+
+    /**
+     * Tetrahedral interpolation, the cell is split along its grey diagonal so neutrals stay neutral.
+     */
+    auto sample(glm::vec3 const& colour) const -> glm::vec3;
+
+    /**
+     * Tetrahedral interpolation of count interleaved pixels, the colour is the first three of every channels
+     * floats and only those are written. Source and destination may be the same buffer.
+     */
+    auto sample(float const* source, float* destination, std::size_t const& count, std::int32_t const& channels) const -> void;
+
+  private:
+    std::int32_t       m_size;
+    glm::vec3          m_min{0.0f};
+    glm::vec3          m_max{1.0f};
+    std::vector<float> m_table;
+};
+
+/**
+ * Load a 3D table from an Adobe/Resolve .cube file.
+ * @throws std::runtime_error when the file cannot be read or holds no valid 3D table.
+ */
+auto load_cube(std::filesystem::path const& filename) -> lut3d;
+
+/**
+ * Grade the colour channels of source through the cube in parallel row bands, alpha is copied as is.
+ * @param source      Image with at least three channels.
+ * @param destination Output, same dimensions as source, may be the source itself.
+ * @param lut         Colour cube.
+ */
+auto apply_lut(image const& source, image& destination, lut3d const& lut) -> void;
+}
+
+#endif  // IMAGEPP_LUT_HPP
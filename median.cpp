@@ -0,0 +1,136 @@
+/**
+ * @file   median.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Constant time median filter
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "median.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+constexpr std::int32_t bins   = 256;
+constexpr std::int32_t coarse = 16;  // fine bins per coarse bin
+
+/**
+ * Column histograms in two tiers, the coarse tier makes the median search 16 + 16 steps instead of 256.
+ */
+struct histogram {
+    std::array<std::uint32_t, bins>            fine{};
+    std::array<std::uint32_t, bins / coarse>   coarse_bins{};
+
+    auto add(std::uint16_t const* column_fine, std::uint16_t const* column_coarse) -> void {
+        for (std::int32_t i = 0; i < bins; ++i) fine.data()[i] += column_fine[i];
+        for (std::int32_t i = 0; i < bins / coarse; ++i) coarse_bins.data()[i] += column_coarse[i];
+    }
+    auto sub(std::uint16_t const* column_fine, std::uint16_t const* column_coarse) -> void {
+        for (std::int32_t i = 0; i < bins; ++i) fine.data()[i] -= column_fine[i];
+        for (std::int32_t i = 0; i < bins / coarse; ++i) coarse_bins.data()[i] -= column_coarse[i];
+    }
+    auto median(std::uint32_t const& half) const -> std::int32_t {
+        std::uint32_t sum = 0;
+        std::int32_t  c = 0;
+        for (; c < bins / coarse - 1; ++c) {
+            if (sum + coarse_bins.data()[c] > half) break;
+            sum += coarse_bins.data()[c];
+        }
+        auto b = c * coarse;
+        for (; b < bins - 1; ++b) {
+            sum += fine.data()[b];
+            if (sum > half) break;
+        }
+        return b;
+    }
+};
+
+auto quantise(float const& value) -> std::int32_t {
+    return std::clamp(static_cast<std::int32_t>(value * 255.0f + 0.5f), 0, bins - 1);
+}
+}
+
+auto median_filter(image const& source, image& destination, std::int32_t const& radius) -> void {
+    if (radius < 0) throw std::invalid_argument("nrv::median_filter: radius must not be negative");
+    if (source.buffer() == destination.buffer())
+        throw std::invalid_argument("nrv::median_filter: source and destination must be different images");
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::median_filter: source and destination dimensions differ");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+    auto const workers  = static_cast<std::int32_t>(default_pool().size());
+    auto const strip    = std::max((width + workers - 1) / workers, 64);
+    auto const strips   = (width + strip - 1) / strip;
+    auto const half     = static_cast<std::uint32_t>((2 * radius + 1) * (2 * radius + 1) / 2);
+
+    auto const sample = [&](std::int32_t const& x, std::int32_t const& y, std::int32_t const& c) {
+        auto const sx = std::clamp(x, 0, width - 1);
+        auto const sy = std::clamp(y, 0, height - 1);
+        return quantise(source.buffer()[(static_cast<std::size_t>(sy) * static_cast<std::size_t>(width)
+                                       + static_cast<std::size_t>(sx)) * static_cast<std::size_t>(channels)
+                                       + static_cast<std::size_t>(c)]);
+    };
+
+    parallel_for(strips, [&](std::int32_t const& index) {
+        auto const x0      = index * strip;
+        auto const x1      = std::min(x0 + strip, width);
+        auto const first   = x0 - radius;
+        auto const columns = x1 - x0 + 2 * radius;
+
+        std::vector<std::uint16_t> fine(static_cast<std::size_t>(columns * bins));
+        std::vector<std::uint16_t> rough(static_cast<std::size_t>(columns * (bins / coarse)));
+        auto const column = [&](std::int32_t const& j) { return fine.data() + j * bins; };
+        auto const column_coarse = [&](std::int32_t const& j) { return rough.data() + j * (bins / coarse); };
+        auto const update = [&](std::int32_t const& j, std::int32_t const& value, std::uint16_t const& delta) {
+            column(j)[value] = static_cast<std::uint16_t>(column(j)[value] + delta);
+            column_coarse(j)[value / coarse] = static_cast<std::uint16_t>(column_coarse(j)[value / coarse] + delta);
+        };
+
+        for (std::int32_t c = 0; c < channels; ++c) {
+            std::fill(fine.begin(), fine.end(), std::uint16_t{0});
+            std::fill(rough.begin(), rough.end(), std::uint16_t{0});
+            for (std::int32_t j = 0; j < columns; ++j)
+                for (auto i = -radius; i <= radius; ++i) update(j, sample(first + j, i, c), 1);
+
+            for (std::int32_t y = 0; y < height; ++y) {
+                if (y > 0) {
+                    for (std::int32_t j = 0; j < columns; ++j) {
+                        update(j, sample(first + j, y - radius - 1, c), std::uint16_t(0xffff));
+                        update(j, sample(first + j, y + radius, c), 1);
+                    }
+                }
+
+                histogram kernel{};
+                for (std::int32_t j = 0; j < 2 * radius + 1; ++j) kernel.add(column(j), column_coarse(j));
+
+                auto* out = destination.buffer() + (static_cast<std::size_t>(y) * static_cast<std::size_t>(width)
+                                                 + static_cast<std::size_t>(x0)) * static_cast<std::size_t>(channels)
+                                                 + static_cast<std::size_t>(c);
+                for (auto x = x0; x < x1; ++x) {
+                    auto const j = x - x0;
+                    if (j > 0) {
+                        kernel.add(column(j + 2 * radius), column_coarse(j + 2 * radius));
+                        kernel.sub(column(j - 1), column_coarse(j - 1));
+                    }
+                    out[j * channels] = static_cast<float>(kernel.median(half)) / 255.0f;
+                }
+            }
+        }
+    });
+}
+
+auto median_filter(image const& source, std::int32_t const& radius) -> image {
+    image output{source.width(), source.height(), source.channels()};
+    median_filter(source, output, radius);
+    return output;
+}
+}
@@ -0,0 +1,30 @@
+/**
+ * @file   median.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Constant time median filter
+ *         Perreault & Hébert, Median Filtering in Constant Time, 2007
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_MEDIAN_HPP
+#define IMAGEPP_MEDIAN_HPP
+
+#include <cstdint>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Median over a (2 * radius + 1)^2 window, every channel on its own with 8-bit precision.
+ * Column histograms are slid down the image and aggregated across the row, so the cost per pixel
+ * does not grow with the radius. Runs in parallel over vertical strips, edges are clamped.
+ * @param source      Image to filter, values in [0, 1].
+ * @param destination Filtered output, same dimensions as source.
+ * @param radius      Window radius in pixels.
+ */
+auto median_filter(image const& source, image& destination, std::int32_t const& radius = 1) -> void;
+auto median_filter(image const& source, std::int32_t const& radius = 1) -> image;
+}
+
+#endif  // IMAGEPP_MEDIAN_HPP
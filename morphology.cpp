@@ -0,0 +1,214 @@
+/**
+ * @file   morphology.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Erosion, dilation, opening and closing with rectangular structuring elements
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "morphology.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+constexpr std::int32_t strip_lanes = 256;
+
+struct min_op { auto operator()(float const& a, float const& b) const -> float { return std::min(a, b); } };
+struct max_op { auto operator()(float const& a, float const& b) const -> float { return std::max(a, b); } };
+struct and_op { auto operator()(std::uint64_t const& a, std::uint64_t const& b) const -> std::uint64_t { return a & b; } };
+struct or_op  { auto operator()(std::uint64_t const& a, std::uint64_t const& b) const -> std::uint64_t { return a | b; } };
+
+/**
+ * van Herk/Gil-Werman running min/max over a window of 2 * radius + 1 elements.
+ * The sequence is padded with neutral elements and cut into blocks of the window size, a window then
+ * always spans the suffix of one block and the prefix of the next, which costs 3 operations per element.
+ * Every element is a group of `lanes` contiguous values processed side by side.
+ * @param in     First element, element i starts at in + i * stride.
+ * @param out    Output with the same layout as in.
+ * @param count  Number of elements.
+ * @param stride Distance between elements.
+ * @param lanes  Values per element.
+ * @param g, h   Scratch for (count + 2 * radius) * lanes values.
+ */
+template <typename T, typename Op>
+auto van_herk(T const* in, T* out, std::int32_t const& count, std::int32_t const& stride, std::int32_t const& lanes,
+              std::int32_t const& radius, T const& neutral, Op const& op, T* g, T* h) -> void {
+    auto const window = 2 * radius + 1;
+    auto const padded = count + 2 * radius;
+    auto const value  = [&](std::int32_t const& j, std::int32_t const& l) {
+        auto const i = j - radius;
+        return i < 0 || i >= count ? neutral : in[i * stride + l];
+    };
+
+    for (std::int32_t j = 0; j < padded; ++j) {
+        auto* gj = g + j * lanes;
+        if (j % window == 0) {
+            for (std::int32_t l = 0; l < lanes; ++l) gj[l] = value(j, l);
+        } else {
+            auto const* gp = gj - lanes;
+            for (std::int32_t l = 0; l < lanes; ++l) gj[l] = op(gp[l], value(j, l));
+        }
+    }
+    for (auto j = padded - 1; j >= 0; --j) {
+        auto* hj = h + j * lanes;
+        if (j % window == window - 1 || j == padded - 1) {
+            for (std::int32_t l = 0; l < lanes; ++l) hj[l] = value(j, l);
+        } else {
+            auto const* hn = hj + lanes;
+            for (std::int32_t l = 0; l < lanes; ++l) hj[l] = op(hn[l], value(j, l));
+        }
+    }
+    for (std::int32_t i = 0; i < count; ++i) {
+        auto const* hi = h + i * lanes;
+        auto const* gi = g + (i + window - 1) * lanes;
+        auto* o = out + i * stride;
+        for (std::int32_t l = 0; l < lanes; ++l) o[l] = op(hi[l], gi[l]);
+    }
+}
+
+template <typename Op>
+auto morph(image const& source, image& destination, std::int32_t const& radius_x, std::int32_t const& radius_y,
+           float const& neutral, Op const& op) -> void {
+    if (radius_x < 0 || radius_y < 0) throw std::invalid_argument("nrv::morphology: radius must not be negative");
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::morphology: source and destination dimensions differ");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+    auto const row_size = width * channels;
+
+    // Horizontal pass row by row, the channels of a pixel are the lanes.
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        std::vector<float> g(static_cast<std::size_t>((width + 2 * radius_x) * channels));
+        std::vector<float> h(g.size());
+        std::vector<float> line(static_cast<std::size_t>(row_size));
+        for (auto y = begin; y < end; ++y) {
+            auto const offset = static_cast<std::size_t>(y) * static_cast<std::size_t>(row_size);
+            std::copy_n(source.buffer() + offset, row_size, line.data());
+            van_herk(line.data(), destination.buffer() + offset, width, channels, channels, radius_x, neutral, op, g.data(), h.data());
+        }
+    });
+
+    // Vertical pass over column strips, a whole strip of a row is one element so the lanes are contiguous.
+    auto const strips = (row_size + strip_lanes - 1) / strip_lanes;
+    parallel_for(strips, [&](std::int32_t const& index) {
+        auto const first = index * strip_lanes;
+        auto const lanes = std::min(strip_lanes, row_size - first);
+        std::vector<float> g(static_cast<std::size_t>((height + 2 * radius_y) * lanes));
+        std::vector<float> h(g.size());
+        auto* column = destination.buffer() + first;
+        van_herk(static_cast<float const*>(column), column, height, row_size, lanes, radius_y, neutral, op, g.data(), h.data());
+    });
+}
+
+/**
+ * dst(x) = src(x + offset) for every bit of a packed row, bits outside the row read as fill.
+ */
+auto shift_row(std::uint64_t const* src, std::uint64_t* dst, std::int32_t const& words, std::int32_t const& offset,
+               std::uint64_t const& fill) -> void {
+    auto const q = offset >= 0 ? offset / 64 : -((-offset + 63) / 64);
+    auto const b = offset - q * 64;
+    auto const word = [&](std::int32_t const& i) { return i < 0 || i >= words ? fill : src[i]; };
+    for (std::int32_t i = 0; i < words; ++i) {
+        auto const lo = word(i + q);
+        dst[i] = b == 0 ? lo : (lo >> b) | (word(i + q + 1) << (64 - b));
+    }
+}
+
+template <typename Op>
+auto morph(bitmap const& source, bitmap& destination, std::int32_t const& radius_x, std::int32_t const& radius_y,
+           std::uint64_t const& neutral, Op const& op) -> void {
+    if (radius_x < 0 || radius_y < 0) throw std::invalid_argument("nrv::morphology: radius must not be negative");
+    if (source.width() != destination.width() || source.height() != destination.height())
+        throw std::invalid_argument("nrv::morphology: source and destination dimensions differ");
+
+    auto const height = source.height();
+    auto const words  = source.stride();
+    auto const tail   = source.tail_mask();
+
+    // Horizontal pass, the window is built from doubling spans: log2(window) shifts per word instead of window.
+    // Rows are widened so the 2 * radius_x pixels past the right edge still fit while spans are shifted.
+    auto const extended = (source.width() + 2 * radius_x + 63) / 64;
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        std::vector<std::uint64_t> span(static_cast<std::size_t>(extended));
+        std::vector<std::uint64_t> acc(span.size());
+        std::vector<std::uint64_t> tmp(span.size());
+        for (auto y = begin; y < end; ++y) {
+            // Start the window radius_x pixels to the left so acc(x) ends up covering [x - radius_x, x + radius_x].
+            std::fill(tmp.begin(), tmp.end(), neutral);
+            std::copy_n(source.row(y), words, tmp.data());
+            tmp[static_cast<std::size_t>(words - 1)] = (tmp[static_cast<std::size_t>(words - 1)] & tail) | (neutral & ~tail);
+            shift_row(tmp.data(), span.data(), extended, -radius_x, neutral);
+            std::fill(acc.begin(), acc.end(), neutral);
+
+            std::int32_t length = 0;
+            std::int32_t size   = 1;
+            for (auto remaining = 2 * radius_x + 1; remaining > 0; remaining >>= 1) {
+                if (remaining & 1) {
+                    shift_row(span.data(), tmp.data(), extended, length, neutral);
+                    for (std::int32_t i = 0; i < extended; ++i) acc.data()[i] = op(acc.data()[i], tmp.data()[i]);
+                    length += size;
+                }
+                if (remaining > 1) {
+                    shift_row(span.data(), tmp.data(), extended, size, neutral);
+                    for (std::int32_t i = 0; i < extended; ++i) span.data()[i] = op(span.data()[i], tmp.data()[i]);
+                    size *= 2;
+                }
+            }
+            std::copy_n(acc.begin(), words, destination.row(y));
+        }
+    });
+
+    // Vertical pass, whole rows of words are the lanes.
+    auto const strips = (words + strip_lanes - 1) / strip_lanes;
+    parallel_for(strips, [&](std::int32_t const& index) {
+        auto const first = index * strip_lanes;
+        auto const lanes = std::min(strip_lanes, words - first);
+        std::vector<std::uint64_t> g(static_cast<std::size_t>((height + 2 * radius_y) * lanes));
+        std::vector<std::uint64_t> h(g.size());
+        auto* column = destination.buffer() + first;
+        van_herk(static_cast<std::uint64_t const*>(column), column, height, words, lanes, radius_y, neutral, op, g.data(), h.data());
+    });
+
+    for (std::int32_t y = 0; y < height; ++y) destination.row(y)[words - 1] &= tail;
+}
+}
+
+auto erode(image const& source, image& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void {
+    morph(source, destination, radius_x, radius_y, std::numeric_limits<float>::infinity(), min_op{});
+}
+auto dilate(image const& source, image& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void {
+    morph(source, destination, radius_x, radius_y, -std::numeric_limits<float>::infinity(), max_op{});
+}
+auto opening(image const& source, image& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void {
+    erode(source, destination, radius_x, radius_y);
+    dilate(destination, destination, radius_x, radius_y);
+}
+auto closing(image const& source, image& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void {
+    dilate(source, destination, radius_x, radius_y);
+    erode(destination, destination, radius_x, radius_y);
+}
+
+auto erode(bitmap const& source, bitmap& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void {
+    morph(source, destination, radius_x, radius_y, ~std::uint64_t{0}, and_op{});
+}
+auto dilate(bitmap const& source, bitmap& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void {
+    morph(source, destination, radius_x, radius_y, std::uint64_t{0}, or_op{});
+}
+auto opening(bitmap const& source, bitmap& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void {
+    erode(source, destination, radius_x, radius_y);
+    dilate(destination, destination, radius_x, radius_y);
+}
+auto closing(bitmap const& source, bitmap& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void {
+    dilate(source, destination, radius_x, radius_y);
+    erode(destination, destination, radius_x, radius_y);
+}
+}
@@ -0,0 +1,41 @@
+/**
+ * @file   morphology.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Erosion, dilation, opening and closing with rectangular structuring elements
+ *         van Herk, Gil & Werman, constant cost per pixel for any element size
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_MORPHOLOGY_HPP
+#define IMAGEPP_MORPHOLOGY_HPP
+
+#include <cstdint>
+
+#include "image.hpp"
+#include "bitmap.hpp"
+
+namespace nrv {
+/**
+ * Minimum (erode) or maximum (dilate) over a (2 * radius_x + 1) x (2 * radius_y + 1) rectangle,
+ * pixels outside the image are ignored. Every channel is processed on its own.
+ * @param source      Image to process.
+ * @param destination Output, same dimensions as source, may be the source itself.
+ * @param radius_x    Horizontal radius of the structuring element.
+ * @param radius_y    Vertical radius of the structuring element.
+ */
+auto erode(image const& source, image& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void;
+auto dilate(image const& source, image& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void;
+auto opening(image const& source, image& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void;
+auto closing(image const& source, image& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void;
+
+/**
+ * Bit parallel variants on packed 1-bit images, 64 pixels per word operation.
+ */
+auto erode(bitmap const& source, bitmap& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void;
+auto dilate(bitmap const& source, bitmap& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void;
+auto opening(bitmap const& source, bitmap& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void;
+auto closing(bitmap const& source, bitmap& destination, std::int32_t const& radius_x, std::int32_t const& radius_y) -> void;
+}
+
+#endif  // IMAGEPP_MORPHOLOGY_HPP
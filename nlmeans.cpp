@@ -0,0 +1,133 @@
+/**
+ * @file   nlmeans.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Non-local means denoising
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "nlmeans.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+constexpr std::int32_t band_height = 32;
+}
+
+auto non_local_means(image const& source, image& destination, float const& sigma, std::int32_t const& search_radius,
+                     std::int32_t const& patch_radius, float const& strength) -> void {
+    if (!(sigma > 0.0f) || !(strength > 0.0f))
+        throw std::invalid_argument("nrv::non_local_means: sigma and strength must be positive");
+    if (search_radius < 0 || search_radius > nlm_max_search_radius || patch_radius < 0 || patch_radius > nlm_max_patch_radius)
+        throw std::invalid_argument("nrv::non_local_means: search or patch radius out of range");
+    if (source.buffer() == destination.buffer())
+        throw std::invalid_argument("nrv::non_local_means: source and destination must be different images");
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::non_local_means: source and destination dimensions differ");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+    auto const margin   = search_radius + patch_radius;
+
+    // Edge clamped copy so every offset and patch read is in bounds.
+    auto const padded_width  = width  + 2 * margin;
+    auto const padded_height = height + 2 * margin;
+    auto const padded_stride = padded_width * channels;
+    std::vector<float> padded(static_cast<std::size_t>(padded_stride) * static_cast<std::size_t>(padded_height));
+    parallel_for_range(padded_height, 32, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const sy = std::clamp(y - margin, 0, height - 1);
+            auto const* in = source.buffer() + static_cast<std::size_t>(sy) * static_cast<std::size_t>(width * channels);
+            auto* out = padded.data() + static_cast<std::ptrdiff_t>(y) * padded_stride;
+            for (std::int32_t x = 0; x < padded_width; ++x)
+                std::copy_n(in + std::clamp(x - margin, 0, width - 1) * channels, channels, out + x * channels);
+        }
+    });
+
+    auto const patch   = 2 * patch_radius + 1;
+    auto const scale   = 1.0f / static_cast<float>(patch * patch * channels);
+    auto const bias    = 2.0f * sigma * sigma;
+    auto const inv_h2  = 1.0f / (strength * sigma * strength * sigma);
+    auto const bands   = (height + band_height - 1) / band_height;
+
+    parallel_for(bands, [&](std::int32_t const& band) {
+        auto const y0   = band * band_height;
+        auto const rows = std::min(band_height, height - y0);
+
+        // Table over the band plus the patch halo, zero first row and column.
+        auto const table_width  = width + 2 * patch_radius;
+        auto const table_height = rows + 2 * patch_radius;
+        auto const table_stride = table_width + 1;
+        std::vector<double> table(static_cast<std::size_t>(table_stride) * static_cast<std::size_t>(table_height + 1), 0.0);
+        std::vector<float>  diff(static_cast<std::size_t>(table_width));
+        std::vector<float>  weight(static_cast<std::size_t>(width));
+        std::vector<float>  acc(static_cast<std::size_t>(rows * width * channels), 0.0f);
+        std::vector<float>  total(static_cast<std::size_t>(rows * width), 0.0f);
+
+        // Pixel (x, y) of the band in padded coordinates, x in [-patch_radius, width + patch_radius).
+        auto const pixel = [&](std::int32_t const& x, std::int32_t const& y) {
+            return padded.data() + static_cast<std::ptrdiff_t>(y0 + y + margin) * padded_stride + (x + margin) * channels;
+        };
+
+        for (auto dy = -search_radius; dy <= search_radius; ++dy) {
+            for (auto dx = -search_radius; dx <= search_radius; ++dx) {
+                // Squared differences between the image and its shifted copy, integrated over the band.
+                for (std::int32_t i = 0; i < table_height; ++i) {
+                    auto const* a = pixel(-patch_radius, i - patch_radius);
+                    auto const* b = pixel(-patch_radius + dx, i - patch_radius + dy);
+                    auto* d = diff.data();
+                    for (std::int32_t j = 0; j < table_width; ++j) {
+                        auto sum = 0.0f;
+                        for (std::int32_t c = 0; c < channels; ++c) {
+                            auto const delta = a[j * channels + c] - b[j * channels + c];
+                            sum += delta * delta;
+                        }
+                        d[j] = sum;
+                    }
+                    auto* row   = table.data() + static_cast<std::ptrdiff_t>(i + 1) * table_stride;
+                    auto const* above = row - table_stride;
+                    auto running = 0.0;
+                    for (std::int32_t j = 0; j < table_width; ++j) {
+                        running += d[j];
+                        row[j + 1] = above[j + 1] + running;
+                    }
+                }
+
+                for (std::int32_t i = 0; i < rows; ++i) {
+                    auto const* top    = table.data() + static_cast<std::ptrdiff_t>(i) * table_stride;
+                    auto const* bottom = top + patch * table_stride;
+                    auto* w = weight.data();
+                    for (std::int32_t j = 0; j < width; ++j) {
+                        auto const distance = static_cast<float>(bottom[j + patch] - bottom[j] - top[j + patch] + top[j]) * scale;
+                        w[j] = std::exp(-std::max(distance - bias, 0.0f) * inv_h2);
+                    }
+
+                    auto const* shifted = pixel(dx, i + dy);
+                    auto* sum  = acc.data() + static_cast<std::ptrdiff_t>(i) * width * channels;
+                    auto* norm = total.data() + static_cast<std::ptrdiff_t>(i) * width;
+                    for (std::int32_t j = 0; j < width; ++j) {
+                        for (std::int32_t c = 0; c < channels; ++c) sum[j * channels + c] += w[j] * shifted[j * channels + c];
+                        norm[j] += w[j];
+                    }
+                }
+            }
+        }
+
+        for (std::int32_t i = 0; i < rows; ++i) {
+            auto const* sum  = acc.data() + static_cast<std::ptrdiff_t>(i) * width * channels;
+            auto const* norm = total.data() + static_cast<std::ptrdiff_t>(i) * width;
+            auto* out = destination.buffer() + static_cast<std::ptrdiff_t>(y0 + i) * width * channels;
+            for (std::int32_t j = 0; j < width; ++j)
+                for (std::int32_t c = 0; c < channels; ++c) out[j * channels + c] = sum[j * channels + c] / norm[j];
+        }
+    });
+}
+}
@@ -0,0 +1,37 @@
+/**
+ * @file   nlmeans.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Non-local means denoising
+ *         Buades, Coll & Morel, Non-Local Means Denoising, IPOL 2011
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_NLMEANS_HPP
+#define IMAGEPP_NLMEANS_HPP
+
+#include <cstdint>
+
+#include "image.hpp"
+
+namespace nrv {
+constexpr std::int32_t nlm_max_search_radius = 17;
+constexpr std::int32_t nlm_max_patch_radius  = 4;
+
+/**
+ * Non-local means, every pixel becomes the weighted mean of the pixels in its search window with weights
+ * from the similarity of the patches around them. Patch distances for one offset come from a summed-area
+ * table of squared differences, so every offset costs O(1) per pixel and the runtime is
+ * (2 * search_radius + 1)^2 passes over the image whatever the patch size.
+ * @param source        Noisy image, values in [0, 1].
+ * @param destination   Denoised output, same dimensions as source.
+ * @param sigma         Standard deviation of the noise.
+ * @param search_radius Search window radius, at most nlm_max_search_radius.
+ * @param patch_radius  Patch radius, at most nlm_max_patch_radius.
+ * @param strength      Filtering parameter h as a multiple of sigma.
+ */
+auto non_local_means(image const& source, image& destination, float const& sigma, std::int32_t const& search_radius = 10,
+                     std::int32_t const& patch_radius = 1, float const& strength = 0.55f) -> void;
+}
+
+#endif  // IMAGEPP_NLMEANS_HPP
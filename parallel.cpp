@@ -0,0 +1,112 @@
+/**
+ * @file   parallel.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Worker pool and parallel loops
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nrv {
+namespace {
+thread_local bool t_inside_job = false;
+}
+
+worker_pool::worker_pool(std::size_t const& count) {
+    auto const workers = std::max(count, std::size_t{1}) - 1;
+    m_workers.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i)
+        m_workers.emplace_back([this] { work(); });
+}
+worker_pool::~worker_pool() {
+    {
+        std::scoped_lock lock{m_mutex};
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) worker.join();
+}
+
+auto worker_pool::parallel_for(std::int32_t const& count, index_fn_t const& fn) -> void {
+    if (count <= 0) return;
+    if (t_inside_job || m_workers.empty() || count == 1) {
+        for (std::int32_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::scoped_lock submit{m_submit};
+    {
+        std::scoped_lock lock{m_mutex};
+        m_fn     = &fn;
+        m_count  = count;
+        m_next   = 0;
+        m_active = m_workers.size();
+        m_error  = nullptr;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    t_inside_job = true;
+    run_job();
+    t_inside_job = false;
+
+    std::unique_lock lock{m_mutex};
+    m_done.wait(lock, [this] { return m_active == 0; });
+    m_fn = nullptr;
+    if (m_error) std::rethrow_exception(std::exchange(m_error, nullptr));
+}
+
+auto worker_pool::work() -> void {
+    t_inside_job = true;
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock lock{m_mutex};
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+        }
+        run_job();
+        {
+            std::scoped_lock lock{m_mutex};
+            if (--m_active == 0) m_done.notify_all();
+        }
+    }
+}
+
+auto worker_pool::run_job() -> void {
+    for (auto i = m_next.fetch_add(1); i < m_count; i = m_next.fetch_add(1)) {
+        try {
+            (*m_fn)(i);
+        } catch (...) {
+            std::scoped_lock lock{m_mutex};
+            if (!m_error) m_error = std::current_exception();
+            m_next = m_count;
+        }
+    }
+}
+
+auto default_pool() -> worker_pool& {
+    static worker_pool pool{};
+    return pool;
+}
+
+auto parallel_for(std::int32_t const& count, index_fn_t const& fn) -> void {
+    default_pool().parallel_for(count, fn);
+}
+
+auto parallel_for_range(std::int32_t const& count, std::int32_t const& grain, range_fn_t const& fn) -> void {
+    if (count <= 0) return;
+    auto const workers = static_cast<std::int32_t>(default_pool().size());
+    auto const bands   = std::clamp(count / std::max(grain, 1), 1, workers * 4);
+    parallel_for(bands, [&](std::int32_t const& band) {
+        auto const begin = static_cast<std::int32_t>(std::int64_t{count} * band / bands);
+        auto const end   = static_cast<std::int32_t>(std::int64_t{count} * (band + 1) / bands);
+        if (begin < end) fn(begin, end);
+    });
+}
+}
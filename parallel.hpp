@@ -0,0 +1,85 @@
+/**
+ * @file   parallel.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Worker pool and parallel loops
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_PARALLEL_HPP
+#define IMAGEPP_PARALLEL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nrv {
+using index_fn_t = std::function<void(std::int32_t const& index)>;
+using range_fn_t = std::function<void(std::int32_t const& begin, std::int32_t const& end)>;
+
+/**
+ * Fixed set of worker threads that runs one indexed job at a time.
+ * The calling thread takes part in the job, nested calls from inside a job run serially.
+ */
+class worker_pool {
+  public:
+    worker_pool(std::size_t const& count = std::thread::hardware_concurrency());
+    ~worker_pool();
+    worker_pool(worker_pool const&) = delete;
+    auto operator=(worker_pool const&) -> worker_pool& = delete;
+
+    auto size() const -> std::size_t { return m_workers.size() + 1; }
+
+    /**
+     * Run fn(i) for every i in [0, count) and wait for all of them to finish.
+     * The first exception thrown by fn is rethrown on the calling thread.
+     * @param count Number of work items.
+     * @param fn    Work item function.
+     */
+    auto parallel_for(std::int32_t const& count, index_fn_t const& fn) -> void;
+
+  private:
+    auto work() -> void;
+    auto run_job() -> void;
+
+  private:
+    std::vector<std::thread> m_workers{};
+    std::mutex               m_submit{};
+    std::mutex               m_mutex{};
+    std::condition_variable  m_wake{};
+    std::condition_variable  m_done{};
+    bool                     m_stop{false};
+    std::uint64_t            m_generation{0};
+    std::size_t              m_active{0};
+    index_fn_t const*        m_fn{nullptr};
+    std::int32_t             m_count{0};
+    std::atomic<std::int32_t> m_next{0};
+    std::exception_ptr       m_error{nullptr};
+};
+
+/**
+ * Process wide worker pool sized to the hardware concurrency.
+ */
+auto default_pool() -> worker_pool&;
+
+/**
+ * Run fn(i) for every i in [0, count) on the default worker pool.
+ */
+auto parallel_for(std::int32_t const& count, index_fn_t const& fn) -> void;
+
+/**
+ * Split [0, count) into contiguous bands of at least grain items and run fn(begin, end) on each band.
+ * @param count Number of items, usually image rows.
+ * @param grain Minimum band size, keeps tiny bands from drowning in scheduling overhead.
+ * @param fn    Band function.
+ */
+auto parallel_for_range(std::int32_t const& count, std::int32_t const& grain, range_fn_t const& fn) -> void;
+}
+
+#endif  // IMAGEPP_PARALLEL_HPP
@@ -0,0 +1,309 @@
+/**
+ * @file   png.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Parallel PNG encoder
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "png.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+#include "deflate.hpp"
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+constexpr std::size_t idat_size = 1 << 20;  // Image data chunk size, chunk CRCs are computed in parallel
+
+auto put_u32(std::vector<std::uint8_t>& out, std::uint32_t const& value) -> void {
+    for (std::int32_t shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<std::uint8_t>(value >> shift));
+}
+
+auto chunk_header(std::vector<std::uint8_t>& out, char const* type, std::size_t const& size) -> void {
+    put_u32(out, static_cast<std::uint32_t>(size));
+    out.insert(out.end(), type, type + 4);
+}
+
+auto chunk_crc(char const* type, std::uint8_t const* data, std::size_t const& size) -> std::uint32_t {
+    auto const crc = crc32(reinterpret_cast<std::uint8_t const*>(type), 4);
+    return crc32(data, size, crc);
+}
+
+auto write_chunk(std::vector<std::uint8_t>& out, char const* type, std::uint8_t const* data, std::size_t const& size) -> void {
+    chunk_header(out, type, size);
+    out.insert(out.end(), data, data + size);
+    put_u32(out, chunk_crc(type, data, size));
+}
+
+auto paeth(std::int32_t const& a, std::int32_t const& b, std::int32_t const& c) -> std::int32_t {
+    auto const p  = a + b - c;
+    auto const pa = std::abs(p - a);
+    auto const pb = std::abs(p - b);
+    auto const pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) return a;
+    return pb <= pc ? b : c;
+}
+
+// Filter one row into out, returns the sum of absolute residuals read as signed bytes.
+auto filter_row(png_filter const& filter, std::uint8_t const* row, std::uint8_t const* above, std::size_t const& stride,
+                std::size_t const& bpp, std::uint8_t* out) -> std::uint32_t {
+    std::uint32_t sum = 0;
+    for (std::size_t i = 0; i < stride; ++i) {
+        std::int32_t const a = i >= bpp ? row[i - bpp] : 0;
+        std::int32_t const b = above[i];
+        std::int32_t const c = i >= bpp ? above[i - bpp] : 0;
+        std::int32_t predicted = 0;
+        switch (filter) {
+            case png_filter::sub:     predicted = a; break;
+            case png_filter::up:      predicted = b; break;
+            case png_filter::average: predicted = (a + b) / 2; break;
+            case png_filter::paeth:   predicted = paeth(a, b, c); break;
+            default: break;
+        }
+        auto const value = static_cast<std::uint8_t>(row[i] - predicted);
+        out[i] = value;
+        sum += static_cast<std::uint32_t>(std::abs(static_cast<std::int32_t>(static_cast<std::int8_t>(value))));
+    }
+    return sum;
+}
+
+// Reverse the bits of a byte, bitmaps are least significant bit first and PNG/PBM rows most significant first.
+auto reverse_bits(std::uint8_t const& value) -> std::uint8_t {
+    static auto const table = [] {
+        std::array<std::uint8_t, 256> values{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t r = 0;
+            for (std::int32_t b = 0; b < 8; ++b) r |= ((i >> b) & 1) << (7 - b);
+            values[i] = static_cast<std::uint8_t>(r);
+        }
+        return values;
+    }();
+    return table[value];
+}
+
+auto packed_stride(std::int32_t const& width, std::int32_t const& bit_depth) -> std::size_t {
+    return (static_cast<std::size_t>(width) * static_cast<std::size_t>(bit_depth) + 7) / 8;
+}
+
+// Pack values below 2^bit_depth into rows, the first pixel takes the most significant bits of a byte.
+auto pack_rows(std::uint8_t const* values, std::int32_t const& width, std::int32_t const& height,
+               std::int32_t const& bit_depth) -> std::vector<std::uint8_t> {
+    auto const stride = packed_stride(width, bit_depth);
+    auto const per_byte = 8 / bit_depth;
+    std::vector<std::uint8_t> packed(stride * static_cast<std::size_t>(height), 0);
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const* in = values + static_cast<std::size_t>(y) * static_cast<std::size_t>(width);
+            auto* out = packed.data() + static_cast<std::size_t>(y) * stride;
+            for (std::int32_t x = 0; x < width; ++x) {
+                auto const shift = 8 - bit_depth * (x % per_byte + 1);
+                out[x / per_byte] = static_cast<std::uint8_t>(out[x / per_byte] | in[x] << shift);
+            }
+        }
+    });
+    return packed;
+}
+
+// Bitmap rows as bytes, most significant bit first, optionally inverted for formats where 1 is black.
+// The bitmap must not be empty, the tail mask writes the last byte of every row.
+auto pack_bitmap_rows(bitmap const& bits, bool const& invert) -> std::vector<std::uint8_t> {
+    auto const stride = (static_cast<std::size_t>(bits.width()) + 7) / 8;
+    std::vector<std::uint8_t> packed(stride * static_cast<std::size_t>(bits.height()));
+    auto const tail = bits.width() % 8 == 0 ? std::uint8_t{0xFF} : static_cast<std::uint8_t>(0xFF << (8 - bits.width() % 8));
+    parallel_for_range(bits.height(), 64, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const* words = bits.row(y);
+            auto* out = packed.data() + static_cast<std::size_t>(y) * stride;
+            for (std::size_t i = 0; i < stride; ++i) {
+                auto const byte = reverse_bits(static_cast<std::uint8_t>(words[i / 8] >> (8 * (i % 8))));
+                out[i] = invert ? static_cast<std::uint8_t>(~byte) : byte;
+            }
+            out[stride - 1] &= tail;
+        }
+    });
+    return packed;
+}
+
+// Shared encoder for packed rows of stride bytes. Filters work on whole bytes, bpp is the byte distance
+// to the previous pixel (1 for bit depths below 8) and palette is the PLTE payload, empty for non indexed images.
+auto encode_rows(std::uint8_t const* pixels, std::size_t const& stride, std::int32_t const& width, std::int32_t const& height,
+                 std::uint8_t const& bit_depth, std::uint8_t const& colour_type, std::size_t const& bpp,
+                 std::vector<std::uint8_t> const& palette, png_options const& options) -> std::vector<std::uint8_t> {
+    if (width < 1 || height < 1) throw std::invalid_argument("nrv::encode_png: image must not be empty");
+
+    // Filter rows in parallel, every filtered row starts with its filter type byte. Low bit depth and indexed
+    // rows are left unfiltered unless a filter is forced, byte residuals do not predict them well.
+    auto filter = options.level == 0 ? png_filter::none : options.filter;
+    if (filter == png_filter::adaptive && (bit_depth < 8 || !palette.empty())) filter = png_filter::none;
+    std::vector<std::uint8_t> filtered(static_cast<std::size_t>(height) * (stride + 1));
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        thread_local std::vector<std::uint8_t> zero;
+        thread_local std::vector<std::uint8_t> scratch;
+        zero.assign(stride, 0);
+        scratch.resize(stride);
+        for (auto y = begin; y < end; ++y) {
+            auto const* row   = pixels + static_cast<std::size_t>(y) * stride;
+            auto const* above = y == 0 ? zero.data() : row - stride;
+            auto* out = filtered.data() + static_cast<std::size_t>(y) * (stride + 1);
+            if (filter != png_filter::adaptive) {
+                out[0] = static_cast<std::uint8_t>(filter);
+                filter_row(filter, row, above, stride, bpp, out + 1);
+                continue;
+            }
+            auto best = filter_row(png_filter::none, row, above, stride, bpp, out + 1);
+            out[0] = 0;
+            for (auto const candidate : {png_filter::sub, png_filter::up, png_filter::average, png_filter::paeth}) {
+                auto const sum = filter_row(candidate, row, above, stride, bpp, scratch.data());
+                if (sum >= best) continue;
+                best = sum;
+                out[0] = static_cast<std::uint8_t>(candidate);
+                std::copy(scratch.begin(), scratch.end(), out + 1);
+            }
+        }
+    });
+
+    auto const compressed = zlib_compress(filtered.data(), filtered.size(), {options.level, options.chunk_size});
+
+    // Start from the signature, inserting it into the reserved empty vector trips a false GCC 12
+    // -Wstringop-overflow at -O3.
+    constexpr std::array<std::uint8_t, 8> signature{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<std::uint8_t> result(signature.begin(), signature.end());
+    result.reserve(compressed.size() + compressed.size() / idat_size * 12 + 64);
+
+    std::vector<std::uint8_t> header;
+    put_u32(header, static_cast<std::uint32_t>(width));
+    put_u32(header, static_cast<std::uint32_t>(height));
+    header.insert(header.end(), {bit_depth, colour_type, 0, 0, 0});
+    write_chunk(result, "IHDR", header.data(), header.size());
+    if (!palette.empty()) write_chunk(result, "PLTE", palette.data(), palette.size());
+
+    auto const idats = static_cast<std::int32_t>((compressed.size() + idat_size - 1) / idat_size);
+    std::vector<std::uint32_t> crcs(static_cast<std::size_t>(idats));
+    parallel_for(idats, [&](std::int32_t const& index) {
+        auto const begin = static_cast<std::size_t>(index) * idat_size;
+        crcs[static_cast<std::size_t>(index)] = chunk_crc("IDAT", compressed.data() + begin, std::min(idat_size, compressed.size() - begin));
+    });
+    for (std::size_t i = 0; i < crcs.size(); ++i) {
+        auto const begin = i * idat_size;
+        auto const size  = std::min(idat_size, compressed.size() - begin);
+        chunk_header(result, "IDAT", size);
+        result.insert(result.end(), compressed.begin() + static_cast<std::ptrdiff_t>(begin),
+                      compressed.begin() + static_cast<std::ptrdiff_t>(begin + size));
+        put_u32(result, crcs[i]);
+    }
+    write_chunk(result, "IEND", nullptr, 0);
+    return result;
+}
+}
+
+auto encode_png(std::uint8_t const* pixels, std::int32_t const& width, std::int32_t const& height,
+                std::int32_t const& channels, png_options const& options) -> std::vector<std::uint8_t> {
+    if (channels < 1 || channels > 4) throw std::invalid_argument("nrv::encode_png: only 1 to 4 channels are supported");
+    constexpr std::array<std::uint8_t, 5> colour_type{0, 0, 4, 2, 6};
+    auto const bpp = static_cast<std::size_t>(channels);
+    return encode_rows(pixels, static_cast<std::size_t>(width) * bpp, width, height, 8,
+                       colour_type[static_cast<std::size_t>(channels)], bpp, {}, options);
+}
+
+auto encode_png(bitmap const& bits, png_options const& options) -> std::vector<std::uint8_t> {
+    if (bits.width() < 1 || bits.height() < 1) throw std::invalid_argument("nrv::encode_png: image must not be empty");
+    auto const packed = pack_bitmap_rows(bits, false);
+    return encode_rows(packed.data(), (static_cast<std::size_t>(bits.width()) + 7) / 8, bits.width(), bits.height(),
+                       1, 0, 1, {}, options);
+}
+
+auto encode_png(image const& img, std::int32_t const& bit_depth, png_options const& options) -> std::vector<std::uint8_t> {
+    if (bit_depth != 1 && bit_depth != 2 && bit_depth != 4 && bit_depth != 8)
+        throw std::invalid_argument("nrv::encode_png: bit depth must be 1, 2, 4 or 8");
+    auto const levels = static_cast<float>((1 << bit_depth) - 1);
+    std::vector<std::uint8_t> values(static_cast<std::size_t>(img.width()) * static_cast<std::size_t>(img.height()));
+    auto const channels = img.channels();
+    auto const colour   = channels >= 3;
+    parallel_for_range(img.height(), 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto p = static_cast<std::size_t>(begin) * static_cast<std::size_t>(img.width()); p < static_cast<std::size_t>(end) * static_cast<std::size_t>(img.width()); ++p) {
+            auto const* pixel = img.buffer() + p * static_cast<std::size_t>(channels);
+            auto const grey   = colour ? 0.2126f * pixel[0] + 0.7152f * pixel[1] + 0.0722f * pixel[2] : pixel[0];
+            values[p] = static_cast<std::uint8_t>(std::clamp(grey, 0.0f, 1.0f) * levels + 0.5f);
+        }
+    });
+    auto const packed = pack_rows(values.data(), img.width(), img.height(), bit_depth);
+    return encode_rows(packed.data(), packed_stride(img.width(), bit_depth), img.width(), img.height(),
+                       static_cast<std::uint8_t>(bit_depth), 0, 1, {}, options);
+}
+
+auto encode_png_indexed(std::uint8_t const* indices, std::int32_t const& width, std::int32_t const& height,
+                        std::vector<glm::vec3> const& palette, png_options const& options) -> std::vector<std::uint8_t> {
+    if (palette.empty() || palette.size() > 256) throw std::invalid_argument("nrv::encode_png_indexed: palette must hold 1 to 256 colours");
+    auto const bit_depth = palette.size() <= 2 ? 1 : palette.size() <= 4 ? 2 : palette.size() <= 16 ? 4 : 8;
+    std::vector<std::uint8_t> entries;
+    for (auto const& colour : palette)
+        for (std::int32_t c = 0; c < 3; ++c) entries.push_back(static_cast<std::uint8_t>(std::clamp(colour[c], 0.0f, 1.0f) * 255.0f + 0.5f));
+    auto const count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+    if (std::any_of(indices, indices + count, [&](auto const& index) { return index >= palette.size(); }))
+        throw std::invalid_argument("nrv::encode_png_indexed: index outside the palette");
+    if (bit_depth == 8)
+        return encode_rows(indices, static_cast<std::size_t>(width), width, height, 8, 3, 1, entries, options);
+    auto const packed = pack_rows(indices, width, height, bit_depth);
+    return encode_rows(packed.data(), packed_stride(width, bit_depth), width, height,
+                       static_cast<std::uint8_t>(bit_depth), 3, 1, entries, options);
+}
+
+auto encode_png(image const& img, png_options const& options) -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> pixels(img.size());
+    auto const row = static_cast<std::size_t>(img.width() * img.channels());
+    parallel_for_range(img.height(), 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        auto const first = static_cast<std::size_t>(begin) * row;
+        auto const last  = static_cast<std::size_t>(end) * row;
+        std::transform(img.buffer() + first, img.buffer() + last, pixels.begin() + static_cast<std::ptrdiff_t>(first), [](auto const& pixel) {
+            return static_cast<std::uint8_t>(std::clamp(pixel * 255.0f, 0.0f, 255.0f));
+        });
+    });
+    return encode_png(pixels.data(), img.width(), img.height(), img.channels(), options);
+}
+
+auto write_png(std::string const& filename, image const& img, png_options const& options) -> void {
+    write_file(filename, encode_png(img, options));
+}
+
+auto write_png(std::string const& filename, bitmap const& bits, png_options const& options) -> void {
+    write_file(filename, encode_png(bits, options));
+}
+
+auto encode_pbm(bitmap const& bits) -> std::vector<std::uint8_t> {
+    if (bits.width() < 1 || bits.height() < 1) throw std::invalid_argument("nrv::encode_pbm: bitmap must not be empty");
+    auto const header = "P4\n" + std::to_string(bits.width()) + " " + std::to_string(bits.height()) + "\n";
+    std::vector<std::uint8_t> result(header.begin(), header.end());
+    auto const packed = pack_bitmap_rows(bits, true);
+    result.insert(result.end(), packed.begin(), packed.end());
+    return result;
+}
+
+auto encode_pgm(image const& img) -> std::vector<std::uint8_t> {
+    auto const header = "P5\n" + std::to_string(img.width()) + " " + std::to_string(img.height()) + "\n255\n";
+    std::vector<std::uint8_t> result(header.begin(), header.end());
+    auto const offset   = result.size();
+    auto const channels = img.channels();
+    auto const colour   = channels >= 3;
+    result.resize(offset + static_cast<std::size_t>(img.width()) * static_cast<std::size_t>(img.height()));
+    parallel_for_range(img.height(), 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto p = static_cast<std::size_t>(begin) * static_cast<std::size_t>(img.width()); p < static_cast<std::size_t>(end) * static_cast<std::size_t>(img.width()); ++p) {
+            auto const* pixel = img.buffer() + p * static_cast<std::size_t>(channels);
+            auto const grey   = colour ? 0.2126f * pixel[0] + 0.7152f * pixel[1] + 0.0722f * pixel[2] : pixel[0];
+            result[offset + p] = static_cast<std::uint8_t>(std::clamp(grey * 255.0f, 0.0f, 255.0f));
+        }
+    });
+    return result;
+}
+
+auto write_file(std::string const& filename, std::vector<std::uint8_t> const& data) -> void {
+    std::ofstream file{filename, std::ios::binary};
+    file.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file) throw std::runtime_error("nrv::write_file: error writing file: \"" + filename + "\"");
+}
+}
@@ -0,0 +1,97 @@
+/**
+ * @file   png.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Parallel PNG encoder and binary PBM/PGM writers
+ *         https://www.w3.org/TR/png/
+ *         https://netpbm.sourceforge.net/doc/pbm.html
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_PNG_HPP
+#define IMAGEPP_PNG_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "image.hpp"
+#include "bitmap.hpp"
+
+namespace nrv {
+enum class png_filter {
+    none,
+    sub,
+    up,
+    average,
+    paeth,
+    adaptive,  // Per row, the filter with the smallest sum of absolute residuals
+};
+
+struct png_options {
+    std::int32_t level{6};                   // 0 stores, 1 is the fastest and 9 the smallest
+    png_filter   filter{png_filter::adaptive};  // Ignored when storing, stored data is left unfiltered
+    std::size_t  chunk_size{1 << 17};        // Filtered bytes compressed per parallel chunk
+};
+
+/**
+ * Encode 8-bit pixels as PNG. Rows are filtered in parallel and the image data is compressed in parallel chunks.
+ * @param pixels   width * height * channels bytes, rows are packed.
+ * @param channels 1 grey, 2 grey and alpha, 3 RGB or 4 RGBA.
+ */
+auto encode_png(std::uint8_t const* pixels, std::int32_t const& width, std::int32_t const& height,
+                std::int32_t const& channels, png_options const& options = {}) -> std::vector<std::uint8_t>;
+
+/**
+ * Convert to 8-bit and encode as PNG.
+ */
+auto encode_png(image const& img, png_options const& options = {}) -> std::vector<std::uint8_t>;
+
+/**
+ * Encode a bitmap as 1-bit greyscale PNG straight from its packed rows, set bits are white.
+ * @throws std::invalid_argument when the bitmap is empty.
+ */
+auto encode_png(bitmap const& bits, png_options const& options = {}) -> std::vector<std::uint8_t>;
+
+/**
+ * Encode the luminance as greyscale PNG with 1, 2, 4 or 8 bits per pixel, values are rounded to the nearest level.
+ */
+auto encode_png(image const& img, std::int32_t const& bit_depth, png_options const& options = {}) -> std::vector<std::uint8_t>;
+
+/**
+ * Encode palette indices as indexed PNG, the bit depth is the smallest that holds the palette.
+ * @param indices width * height indices into the palette.
+ * @param palette 1 to 256 colours.
+ */
+auto encode_png_indexed(std::uint8_t const* indices, std::int32_t const& width, std::int32_t const& height,
+                        std::vector<glm::vec3> const& palette, png_options const& options = {}) -> std::vector<std::uint8_t>;
+
+/**
+ * Binary PBM (P4) from the packed rows of a bitmap, set bits are white so they are written as 0.
+ * @throws std::invalid_argument when the bitmap is empty.
+ */
+auto encode_pbm(bitmap const& bits) -> std::vector<std::uint8_t>;
+
+/**
+ * Binary 8-bit PGM (P5) of the luminance.
+ */
+auto encode_pgm(image const& img) -> std::vector<std::uint8_t>;
+
+/**
+ * Convert to 8-bit and save as PNG file with explicit encoder options.
+ */
+auto write_png(std::string const& filename, image const& img, png_options const& options) -> void;
+
+/**
+ * Save a bitmap as 1-bit PNG file.
+ */
+auto write_png(std::string const& filename, bitmap const& bits, png_options const& options = {}) -> void;
+
+/**
+ * Write an encoded file to disk.
+ * @throws std::runtime_error when the file cannot be written.
+ */
+auto write_file(std::string const& filename, std::vector<std::uint8_t> const& data) -> void;
+}
+
+#endif  // IMAGEPP_PNG_HPP
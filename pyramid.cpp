@@ -0,0 +1,163 @@
+/**
+ * @file   pyramid.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Gaussian and Laplacian image pyramids
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "pyramid.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+auto row_at(image const& img, std::int32_t const& y) -> float* {
+    auto const clamped = std::clamp(y, 0, img.height() - 1);
+    return img.buffer() + static_cast<std::size_t>(clamped) * static_cast<std::size_t>(img.width() * img.channels());
+}
+}
+
+pyramid::pyramid(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels, std::int32_t const& levels) {
+    if (width < 1 || height < 1 || channels < 1 || levels < 0)
+        throw std::invalid_argument("nrv::pyramid: invalid dimensions");
+
+    std::vector<std::size_t> offsets{};
+    auto w = width;
+    auto h = height;
+    for (;;) {
+        offsets.push_back(m_size);
+        m_size += static_cast<std::size_t>(w * h * channels);
+        if ((levels != 0 && static_cast<std::int32_t>(offsets.size()) == levels) || (w == 1 && h == 1)) break;
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+
+    m_buffer = std::make_unique<float[]>(m_size);
+    m_levels.reserve(offsets.size());
+    w = width;
+    h = height;
+    for (auto const& offset : offsets) {
+        m_levels.emplace_back(w, h, channels, m_buffer.get() + offset);
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+}
+
+auto downsample(image const& source, image& destination) -> void {
+    if (destination.width() != (source.width() + 1) / 2 || destination.height() != (source.height() + 1) / 2 ||
+        destination.channels() != source.channels())
+        throw std::invalid_argument("nrv::downsample: destination must be half the source size");
+
+    auto const channels = source.channels();
+    auto const row_size = source.width() * channels;
+    auto const pad      = 2 * channels;
+
+    parallel_for_range(destination.height(), 8, [&](std::int32_t const& begin, std::int32_t const& end) {
+        thread_local std::vector<float> column{};
+        column.resize(static_cast<std::size_t>(row_size + 2 * pad));
+        auto* tmp = column.data() + pad;
+
+        for (auto y = begin; y < end; ++y) {
+            // Vertical taps into a padded row, then horizontal taps at every second pixel.
+            auto const* r0 = row_at(source, 2 * y - 2);
+            auto const* r1 = row_at(source, 2 * y - 1);
+            auto const* r2 = row_at(source, 2 * y);
+            auto const* r3 = row_at(source, 2 * y + 1);
+            auto const* r4 = row_at(source, 2 * y + 2);
+            for (std::int32_t i = 0; i < row_size; ++i)
+                tmp[i] = (r0[i] + r4[i] + 4.0f * (r1[i] + r3[i]) + 6.0f * r2[i]) * (1.0f / 16.0f);
+            for (std::int32_t i = 0; i < pad; ++i) {
+                tmp[i - pad]      = tmp[i % channels];
+                tmp[row_size + i] = tmp[row_size - channels + i % channels];
+            }
+
+            auto* out = row_at(destination, y);
+            for (std::int32_t x = 0; x < destination.width(); ++x) {
+                auto const* p = tmp + 2 * x * channels;
+                for (std::int32_t c = 0; c < channels; ++c) {
+                    out[x * channels + c] = (p[c - 2 * channels] + p[c + 2 * channels]
+                                          + 4.0f * (p[c - channels] + p[c + channels])
+                                          + 6.0f * p[c]) * (1.0f / 16.0f);
+                }
+            }
+        }
+    });
+}
+
+auto expand_add(image const& source, image const& base, image& destination, float const& sign) -> void {
+    if (base.width() != destination.width() || base.height() != destination.height() ||
+        base.channels() != destination.channels() || source.channels() != base.channels() ||
+        source.width() != (base.width() + 1) / 2 || source.height() != (base.height() + 1) / 2)
+        throw std::invalid_argument("nrv::expand_add: source must be half the base size");
+
+    auto const channels = source.channels();
+    auto const row_size = source.width() * channels;
+
+    parallel_for_range(destination.height(), 8, [&](std::int32_t const& begin, std::int32_t const& end) {
+        thread_local std::vector<float> column{};
+        column.resize(static_cast<std::size_t>(row_size + channels));
+        auto* tmp = column.data();
+
+        for (auto y = begin; y < end; ++y) {
+            // Even rows sit on a coarse row (1 6 1) / 8, odd rows sit between two (4 4) / 8.
+            auto const k = y / 2;
+            if (y % 2 == 0) {
+                auto const* r0 = row_at(source, k - 1);
+                auto const* r1 = row_at(source, k);
+                auto const* r2 = row_at(source, k + 1);
+                for (std::int32_t i = 0; i < row_size; ++i) tmp[i] = (r0[i] + 6.0f * r1[i] + r2[i]) * 0.125f;
+            } else {
+                auto const* r0 = row_at(source, k);
+                auto const* r1 = row_at(source, k + 1);
+                for (std::int32_t i = 0; i < row_size; ++i) tmp[i] = (r0[i] + r1[i]) * 0.5f;
+            }
+            std::copy_n(tmp + row_size - channels, channels, tmp + row_size);
+
+            auto const* in  = row_at(base, y);
+            auto* out = row_at(destination, y);
+            for (std::int32_t x = 0; x < destination.width(); ++x) {
+                auto const* p = tmp + (x / 2) * channels;
+                auto const* l = x / 2 == 0 ? p : p - channels;
+                for (std::int32_t c = 0; c < channels; ++c) {
+                    auto const value = x % 2 == 0 ? (l[c] + 6.0f * p[c] + p[c + channels]) * 0.125f
+                                                  : (p[c] + p[c + channels]) * 0.5f;
+                    out[x * channels + c] = in[x * channels + c] + sign * value;
+                }
+            }
+        }
+    });
+}
+
+auto gaussian_pyramid(image const& source, std::int32_t const& levels) -> pyramid {
+    pyramid result{source.width(), source.height(), source.channels(), levels};
+    std::copy_n(source.buffer(), source.size(), result.buffer());
+    for (std::int32_t i = 1; i < result.levels(); ++i)
+        downsample(result.level(i - 1), result.level(i));
+    return result;
+}
+
+auto laplacian_pyramid(image const& source, std::int32_t const& levels) -> pyramid {
+    auto result = gaussian_pyramid(source, levels);
+    for (std::int32_t i = 0; i + 1 < result.levels(); ++i)
+        expand_add(result.level(i + 1), result.level(i), result.level(i), -1.0f);
+    return result;
+}
+
+auto collapse(pyramid const& laplacian) -> image {
+    auto const last = laplacian.levels() - 1;
+    image current{laplacian.level(last).width(), laplacian.level(last).height(), laplacian.level(last).channels()};
+    std::copy_n(laplacian.level(last).buffer(), current.size(), current.buffer());
+    for (auto i = last - 1; i >= 0; --i) {
+        auto const& detail = laplacian.level(i);
+        image next{detail.width(), detail.height(), detail.channels()};
+        expand_add(current, detail, next);
+        current = std::move(next);
+    }
+    return current;
+}
+}
@@ -0,0 +1,77 @@
+/**
+ * @file   pyramid.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Gaussian and Laplacian image pyramids
+ *         https://en.wikipedia.org/wiki/Pyramid_(image_processing)
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_PYRAMID_HPP
+#define IMAGEPP_PYRAMID_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Chain of images where every level is half the size of the previous one.
+ * All levels live in one contiguous allocation, level(i) is a view into it.
+ */
+class pyramid {
+  public:
+    /**
+     * Allocate the levels for a source of the given size.
+     * @param levels Number of levels including the full size one, 0 builds the whole chain down to 1x1.
+     */
+    pyramid(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels, std::int32_t const& levels = 0);
+
+    auto levels() const -> std::int32_t { return static_cast<std::int32_t>(m_levels.size()); }
+    auto level(std::int32_t const& index) -> image& { return m_levels[static_cast<std::size_t>(index)]; }
+    auto level(std::int32_t const& index) const -> image const& { return m_levels[static_cast<std::size_t>(index)]; }
+    auto size()   const -> std::size_t { return m_size; }
+    auto buffer() const -> float*      { return m_buffer.get(); }
+
+  private:
+    std::size_t              m_size{0};
+    std::unique_ptr<float[]> m_buffer{};
+    std::vector<image>       m_levels{};
+};
+
+/**
+ * Halve the image with a 5-tap binomial [1 4 6 4 1] / 16 kernel, blur and decimation in one pass.
+ * @param source      Image to reduce.
+ * @param destination Output of size ((width + 1) / 2, (height + 1) / 2).
+ */
+auto downsample(image const& source, image& destination) -> void;
+
+/**
+ * Double the image with the matching binomial interpolation kernel and add it onto base.
+ * destination = base + sign * expand(source), base and destination may be the same image.
+ * @param source      Coarse image.
+ * @param base        Fine image, its size decides the output size.
+ * @param destination Output, same dimensions as base.
+ * @param sign        Weight of the expanded image, 1 to add and -1 to subtract.
+ */
+auto expand_add(image const& source, image const& base, image& destination, float const& sign = 1.0f) -> void;
+
+/**
+ * Gaussian pyramid, level 0 is a copy of the source.
+ */
+auto gaussian_pyramid(image const& source, std::int32_t const& levels = 0) -> pyramid;
+
+/**
+ * Laplacian pyramid, every level holds the detail lost by the next reduction and the last level is the coarse residual.
+ */
+auto laplacian_pyramid(image const& source, std::int32_t const& levels = 0) -> pyramid;
+
+/**
+ * Reconstruct the full size image from a Laplacian pyramid.
+ */
+auto collapse(pyramid const& laplacian) -> image;
+}
+
+#endif  // IMAGEPP_PYRAMID_HPP
@@ -0,0 +1,248 @@
+/**
+ * @file   qoi.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  QOI encoder and decoder with row streaming
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "qoi.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace nrv {
+namespace {
+constexpr std::uint8_t op_index = 0x00;
+constexpr std::uint8_t op_diff  = 0x40;
+constexpr std::uint8_t op_luma  = 0x80;
+constexpr std::uint8_t op_run   = 0xC0;
+constexpr std::uint8_t op_rgb   = 0xFE;
+constexpr std::uint8_t op_rgba  = 0xFF;
+constexpr std::uint8_t op_mask  = 0xC0;
+constexpr std::int32_t max_run  = 62;
+constexpr std::array<std::uint8_t, 8> end_marker{0, 0, 0, 0, 0, 0, 0, 1};
+
+auto pack(std::array<std::uint8_t, 4> const& p) -> std::uint32_t {
+    return std::uint32_t{p[0]} | std::uint32_t{p[1]} << 8 | std::uint32_t{p[2]} << 16 | std::uint32_t{p[3]} << 24;
+}
+
+auto hash(std::array<std::uint8_t, 4> const& p) -> std::size_t {
+    return (std::size_t{p[0]} * 3 + std::size_t{p[1]} * 5 + std::size_t{p[2]} * 7 + std::size_t{p[3]} * 11) % 64;
+}
+
+// Rounded so that i / 255 encodes back to i.
+auto to_u8(float const& value) -> std::uint8_t {
+    return static_cast<std::uint8_t>(std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f));
+}
+
+// Wrapping difference of two channel values as a signed byte.
+auto delta(std::uint8_t const& a, std::uint8_t const& b) -> std::int32_t {
+    return static_cast<std::int8_t>(static_cast<std::uint8_t>(a - b));
+}
+
+auto put_u32(std::ostream& out, std::uint32_t const& value) -> void {
+    for (std::int32_t shift = 24; shift >= 0; shift -= 8) out.put(static_cast<char>(value >> shift));
+}
+}
+
+qoi_encoder::qoi_encoder(std::ostream& out, std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels)
+    : m_out(out), m_width(width), m_height(height), m_channels(channels) {
+    if (width < 1 || height < 1) throw std::invalid_argument("nrv::qoi_encoder: image must not be empty");
+    if (channels < 1 || channels > 4) throw std::invalid_argument("nrv::qoi_encoder: only 1 to 4 channels are supported");
+    m_out.write("qoif", 4);
+    put_u32(m_out, static_cast<std::uint32_t>(width));
+    put_u32(m_out, static_cast<std::uint32_t>(height));
+    m_out.put(channels == 2 || channels == 4 ? 4 : 3);
+    m_out.put(0);  // sRGB with linear alpha
+    // Worst case is an RGBA op per pixel.
+    m_buffer.reserve(static_cast<std::size_t>(width) * 5);
+}
+
+auto qoi_encoder::write_row(float const* row) -> void {
+    if (m_rows == m_height) throw std::runtime_error("nrv::qoi_encoder::write_row: all rows already written");
+    m_buffer.clear();
+    auto const grey  = m_channels < 3;
+    auto const alpha = m_channels == 2 || m_channels == 4;
+    for (std::int32_t x = 0; x < m_width; ++x) {
+        auto const* in = row + x * m_channels;
+        std::array<std::uint8_t, 4> const pixel{
+            to_u8(in[0]),
+            grey ? to_u8(in[0]) : to_u8(in[1]),
+            grey ? to_u8(in[0]) : to_u8(in[2]),
+            alpha ? to_u8(in[m_channels - 1]) : std::uint8_t{255},
+        };
+        if (pixel == m_previous) {
+            if (++m_run == max_run) {
+                m_buffer.push_back(static_cast<std::uint8_t>(op_run | (m_run - 1)));
+                m_run = 0;
+            }
+            continue;
+        }
+        if (m_run > 0) {
+            m_buffer.push_back(static_cast<std::uint8_t>(op_run | (m_run - 1)));
+            m_run = 0;
+        }
+
+        auto const slot = hash(pixel);
+        auto const packed = pack(pixel);
+        if (m_index[slot] == packed) {
+            m_buffer.push_back(static_cast<std::uint8_t>(op_index | slot));
+        } else {
+            m_index[slot] = packed;
+            if (pixel[3] == m_previous[3]) {
+                auto const dr = delta(pixel[0], m_previous[0]);
+                auto const dg = delta(pixel[1], m_previous[1]);
+                auto const db = delta(pixel[2], m_previous[2]);
+                auto const dr_dg = dr - dg;
+                auto const db_dg = db - dg;
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    m_buffer.push_back(static_cast<std::uint8_t>(op_diff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+                    m_buffer.push_back(static_cast<std::uint8_t>(op_luma | (dg + 32)));
+                    m_buffer.push_back(static_cast<std::uint8_t>((dr_dg + 8) << 4 | (db_dg + 8)));
+                } else {
+                    m_buffer.insert(m_buffer.end(), {op_rgb, pixel[0], pixel[1], pixel[2]});
+                }
+            } else {
+                m_buffer.insert(m_buffer.end(), {op_rgba, pixel[0], pixel[1], pixel[2], pixel[3]});
+            }
+        }
+        m_previous = pixel;
+    }
+    m_out.write(reinterpret_cast<char const*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+    ++m_rows;
+}
+
+auto qoi_encoder::finish() -> void {
+    if (m_rows != m_height)
+        throw std::runtime_error("nrv::qoi_encoder::finish: " + std::to_string(m_rows) + " of " + std::to_string(m_height) + " rows written");
+    if (m_run > 0) {
+        m_out.put(static_cast<char>(op_run | (m_run - 1)));
+        m_run = 0;
+    }
+    m_out.write(reinterpret_cast<char const*>(end_marker.data()), static_cast<std::streamsize>(end_marker.size()));
+    m_out.flush();
+    if (!m_out) throw std::runtime_error("nrv::qoi_encoder::finish: error writing stream");
+}
+
+qoi_decoder::qoi_decoder(std::uint8_t const* data, std::size_t const& size) : m_data(data), m_size(size) {
+    if (size < 14 + end_marker.size() || !std::equal(data, data + 4, "qoif"))
+        throw std::runtime_error("nrv::qoi_decoder: not a QOI image");
+    auto const read_u32 = [&](std::size_t const& offset) {
+        return std::uint32_t{data[offset]} << 24 | std::uint32_t{data[offset + 1]} << 16 |
+               std::uint32_t{data[offset + 2]} << 8 | std::uint32_t{data[offset + 3]};
+    };
+    auto const width  = read_u32(4);
+    auto const height = read_u32(8);
+    if (width == 0 || height == 0 || width > 1u << 20 || height > 1u << 20 || (data[12] != 3 && data[12] != 4) || data[13] > 1)
+        throw std::runtime_error("nrv::qoi_decoder: invalid QOI header");
+    // Rows may be read with up to 4 channels, the float image of that size must stay within nrv::image's int32 size.
+    if (std::uint64_t{width} * height * 4 > static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max()))
+        throw std::runtime_error("nrv::qoi_decoder: image too large");
+    m_width    = static_cast<std::int32_t>(width);
+    m_height   = static_cast<std::int32_t>(height);
+    m_channels = data[12];
+}
+
+auto qoi_decoder::read_row(float* row, std::int32_t const& channels) -> void {
+    if (channels < 1 || channels > 4) throw std::invalid_argument("nrv::qoi_decoder::read_row: only 1 to 4 channels are supported");
+    if (m_rows == m_height) throw std::runtime_error("nrv::qoi_decoder::read_row: all rows already read");
+    auto const truncated = [] { return std::runtime_error("nrv::qoi_decoder::read_row: data ends early"); };
+    auto const alpha = channels == 2 || channels == 4;
+    for (std::int32_t x = 0; x < m_width; ++x) {
+        if (m_run > 0) {
+            --m_run;
+        } else {
+            if (m_offset >= m_size) throw truncated();
+            auto const op = m_data[m_offset++];
+            auto const need = [&](std::size_t const& count) {
+                if (m_offset + count > m_size) throw truncated();
+            };
+            if (op == op_rgb) {
+                need(3);
+                std::copy_n(m_data + m_offset, 3, m_pixel.begin());
+                m_offset += 3;
+            } else if (op == op_rgba) {
+                need(4);
+                std::copy_n(m_data + m_offset, 4, m_pixel.begin());
+                m_offset += 4;
+            } else if ((op & op_mask) == op_index) {
+                auto const packed = m_index[op];
+                for (std::size_t c = 0; c < 4; ++c) m_pixel[c] = static_cast<std::uint8_t>(packed >> (8 * c));
+            } else if ((op & op_mask) == op_diff) {
+                m_pixel[0] = static_cast<std::uint8_t>(m_pixel[0] + ((op >> 4) & 3) - 2);
+                m_pixel[1] = static_cast<std::uint8_t>(m_pixel[1] + ((op >> 2) & 3) - 2);
+                m_pixel[2] = static_cast<std::uint8_t>(m_pixel[2] + (op & 3) - 2);
+            } else if ((op & op_mask) == op_luma) {
+                need(1);
+                auto const second = m_data[m_offset++];
+                auto const dg = (op & 0x3F) - 32;
+                m_pixel[0] = static_cast<std::uint8_t>(m_pixel[0] + dg - 8 + ((second >> 4) & 0x0F));
+                m_pixel[1] = static_cast<std::uint8_t>(m_pixel[1] + dg);
+                m_pixel[2] = static_cast<std::uint8_t>(m_pixel[2] + dg - 8 + (second & 0x0F));
+            } else {
+                m_run = op & 0x3F;
+            }
+            m_index[hash(m_pixel)] = pack(m_pixel);
+        }
+
+        auto* out = row + x * channels;
+        auto const r = static_cast<float>(m_pixel[0]) / 255.0f;
+        auto const g = static_cast<float>(m_pixel[1]) / 255.0f;
+        auto const b = static_cast<float>(m_pixel[2]) / 255.0f;
+        if (channels < 3) {
+            // Grey pixels keep their exact value so 1 and 2 channel images survive a write and read.
+            auto const grey = m_pixel[0] == m_pixel[1] && m_pixel[1] == m_pixel[2];
+            out[0] = grey ? r : 0.2126f * r + 0.7152f * g + 0.0722f * b;
+        } else {
+            out[0] = r;
+            out[1] = g;
+            out[2] = b;
+        }
+        if (alpha) out[channels - 1] = static_cast<float>(m_pixel[3]) / 255.0f;
+    }
+    ++m_rows;
+}
+
+auto encode_qoi(image const& img) -> std::vector<std::uint8_t> {
+    std::ostringstream stream;
+    qoi_encoder encoder{stream, img.width(), img.height(), img.channels()};
+    auto const stride = static_cast<std::size_t>(img.width() * img.channels());
+    for (std::int32_t y = 0; y < img.height(); ++y) encoder.write_row(img.buffer() + static_cast<std::size_t>(y) * stride);
+    encoder.finish();
+    auto const data = std::move(stream).str();
+    return {data.begin(), data.end()};
+}
+
+auto decode_qoi(std::uint8_t const* data, std::size_t const& size, std::int32_t const& channels) -> image {
+    qoi_decoder decoder{data, size};
+    image result{decoder.width(), decoder.height(), channels == 0 ? decoder.channels() : channels};
+    auto const stride = static_cast<std::size_t>(result.width() * result.channels());
+    for (std::int32_t y = 0; y < result.height(); ++y) decoder.read_row(result.buffer() + static_cast<std::size_t>(y) * stride, result.channels());
+    return result;
+}
+
+auto write_qoi(std::filesystem::path const& filename, image const& img) -> void {
+    using namespace std::string_literals;
+    std::ofstream file{filename, std::ios::binary};
+    if (!file) throw std::runtime_error("nrv::write_qoi: error writing file: \""s + filename.string() + "\""s);
+    qoi_encoder encoder{file, img.width(), img.height(), img.channels()};
+    auto const stride = static_cast<std::size_t>(img.width() * img.channels());
+    for (std::int32_t y = 0; y < img.height(); ++y) encoder.write_row(img.buffer() + static_cast<std::size_t>(y) * stride);
+    encoder.finish();
+}
+
+auto read_qoi(std::filesystem::path const& filename, std::int32_t const& channels) -> image {
+    using namespace std::string_literals;
+    std::ifstream file{filename, std::ios::binary};
+    if (!file) throw std::runtime_error("nrv::read_qoi: error reading file: \""s + filename.string() + "\""s);
+    std::vector<std::uint8_t> const data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    return decode_qoi(data.data(), data.size(), channels);
+}
+}
@@ -0,0 +1,114 @@
+/**
+ * @file   qoi.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  QOI encoder and decoder with row streaming
+ *         https://qoiformat.org/qoi-specification.pdf
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_QOI_HPP
+#define IMAGEPP_QOI_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Streaming QOI encoder, rows are pushed top to bottom and the encoder state carries across rows.
+ * QOI stores three or four channels, one and two channel rows are written as grey RGB(A).
+ */
+class qoi_encoder {
+  public:
+    /**
+     * Write the header.
+     * @param channels Channels of the rows that will be pushed, 1 to 4.
+     */
+    qoi_encoder(std::ostream& out, std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels);
+
+    /**
+     * Encode one row of width * channels floats.
+     */
+    auto write_row(float const* row) -> void;
+
+    /**
+     * Flush the pending run and write the end marker.
+     * @throws std::runtime_error when fewer rows than the height were written or the stream failed.
+     */
+    auto finish() -> void;
+
+  private:
+    std::ostream&                   m_out;
+    std::int32_t                    m_width;
+    std::int32_t                    m_height;
+    std::int32_t                    m_channels;
+    std::int32_t                    m_rows{0};
+    std::int32_t                    m_run{0};
+    std::array<std::uint8_t, 4>     m_previous{0, 0, 0, 255};
+    std::array<std::uint32_t, 64>   m_index{};
+    std::vector<std::uint8_t>       m_buffer;
+};
+
+/**
+ * Streaming QOI decoder over an encoded buffer, rows are read top to bottom.
+ */
+class qoi_decoder {
+  public:
+    /**
+     * Parse the header.
+     * @throws std::runtime_error when the data is not a QOI image.
+     */
+    qoi_decoder(std::uint8_t const* data, std::size_t const& size);
+
+    auto width()    const -> std::int32_t { return m_width; }
+    auto height()   const -> std::int32_t { return m_height; }
+    auto channels() const -> std::int32_t { return m_channels; }  // Channels stored in the file, 3 or 4
+
+    /**
+     * Decode the next row into width * channels floats, 1 and 2 channels receive Rec.709 luminance.
+     * @throws std::runtime_error when the data ends early.
+     */
+    auto read_row(float* row, std::int32_t const& channels) -> void;
+
+  private:
+    std::uint8_t const*             m_data;
+    std::size_t                     m_size;
+    std::size_t                     m_offset{14};
+    std::int32_t                    m_width{0};
+    std::int32_t                    m_height{0};
+    std::int32_t                    m_channels{0};
+    std::int32_t                    m_rows{0};
+    std::int32_t                    m_run{0};
+    std::array<std::uint8_t, 4>     m_pixel{0, 0, 0, 255};
+    std::array<std::uint32_t, 64>   m_index{};
+};
+
+/**
+ * Encode a whole image as QOI.
+ */
+auto encode_qoi(image const& img) -> std::vector<std::uint8_t>;
+
+/**
+ * Decode a QOI buffer.
+ * @param channels Channels of the returned image, 0 keeps the 3 or 4 channels of the file. QOI has no grey
+ *                 type, pass 1 or 2 to read back a file written from a 1 or 2 channel image.
+ */
+auto decode_qoi(std::uint8_t const* data, std::size_t const& size, std::int32_t const& channels = 0) -> image;
+
+/**
+ * Save as QOI file, rows are streamed to disk without building the whole file in memory.
+ */
+auto write_qoi(std::filesystem::path const& filename, image const& img) -> void;
+
+/**
+ * Load a QOI file, see decode_qoi for the channels.
+ */
+auto read_qoi(std::filesystem::path const& filename, std::int32_t const& channels = 0) -> image;
+}
+
+#endif  // IMAGEPP_QOI_HPP
@@ -0,0 +1,193 @@
+/**
+ * @file   raw.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Native uncompressed image format that can be memory mapped
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "raw.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "deflate.hpp"
+
+namespace nrv {
+namespace {
+auto as_bytes(void const* data) -> std::uint8_t const* {
+    return static_cast<std::uint8_t const*>(data);
+}
+
+auto header_checksum(raw_header const& header) -> std::uint32_t {
+    return crc32(as_bytes(&header), offsetof(raw_header, header_crc));
+}
+
+auto row_bytes(std::int32_t const& width, std::int32_t const& channels) -> std::uint64_t {
+    return static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(channels) * sizeof(float);
+}
+
+// The payload is the in-memory float layout, big-endian hosts would need a byte swap on every sample.
+auto check_host(char const* function) -> void {
+    using namespace std::string_literals;
+    if constexpr (std::endian::native != std::endian::little)
+        throw std::runtime_error(function + ": .nrv images need a little-endian host"s);
+}
+
+auto parse_header(char const* function, std::istream& in, std::filesystem::path const& filename) -> raw_header {
+    using namespace std::string_literals;
+    auto const fail = [&](std::string const& reason) {
+        return std::runtime_error(function + ": \""s + filename.string() + "\" "s + reason);
+    };
+    check_host(function);
+
+    raw_header header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) throw fail("is too short for a .nrv header");
+    if (header.magic != raw_header{}.magic) throw fail("is not a .nrv image");
+    if (header.header_crc != header_checksum(header)) throw fail("has a corrupt header");
+    if (header.version != 1) throw fail("has unsupported version " + std::to_string(header.version));
+    if (header.type != raw_type::f32) throw fail("has unsupported component type");
+    if (header.width < 0 || header.height < 0 || header.channels < 1 || header.channels > 4)
+        throw fail("has invalid dimensions");
+    // nrv::image counts its floats in int32.
+    if (static_cast<std::uint64_t>(header.width) * static_cast<std::uint64_t>(header.height) * static_cast<std::uint64_t>(header.channels) >
+        static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max()))
+        throw fail("is too large");
+    if (header.stride < row_bytes(header.width, header.channels) || header.stride % sizeof(float) != 0)
+        throw fail("has an invalid stride");
+    if (header.offset < sizeof(raw_header) || header.offset % raw_alignment != 0)
+        throw fail("has a misaligned payload");
+    // Divide before multiplying so a huge stride can not wrap around to the payload size.
+    if (header.height > 0 && header.stride > header.payload_size / static_cast<std::uint64_t>(header.height))
+        throw fail("has an invalid payload size");
+    if (header.payload_size != static_cast<std::uint64_t>(header.height) * header.stride)
+        throw fail("has an invalid payload size");
+    auto const file_size = std::filesystem::file_size(filename);
+    if (header.offset > file_size || header.payload_size > file_size - header.offset)
+        throw fail("is truncated");
+    return header;
+}
+}
+
+auto write_raw(std::filesystem::path const& filename, image const& img) -> void {
+    using namespace std::string_literals;
+    check_host("nrv::write_raw");
+    raw_header header{};
+    header.width        = img.width();
+    header.height       = img.height();
+    header.channels     = img.channels();
+    header.stride       = row_bytes(img.width(), img.channels());
+    header.offset       = (sizeof(raw_header) + raw_alignment - 1) / raw_alignment * raw_alignment;
+    header.payload_size = static_cast<std::uint64_t>(img.height()) * header.stride;
+    header.payload_crc  = crc32(as_bytes(img.buffer()), header.payload_size);
+    header.header_crc   = header_checksum(header);
+
+    std::vector<char> padding(header.offset - sizeof(raw_header), 0);
+    std::ofstream file{filename, std::ios::binary};
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    file.write(reinterpret_cast<char const*>(img.buffer()), static_cast<std::streamsize>(header.payload_size));
+    if (!file) throw std::runtime_error("nrv::write_raw: error writing file: \""s + filename.string() + "\""s);
+}
+
+auto read_raw_header(std::filesystem::path const& filename) -> raw_header {
+    using namespace std::string_literals;
+    std::ifstream file{filename, std::ios::binary};
+    if (!file) throw std::runtime_error("nrv::read_raw_header: error reading file: \""s + filename.string() + "\""s);
+    return parse_header("nrv::read_raw_header", file, filename);
+}
+
+auto read_raw(std::filesystem::path const& filename, bool const& verify) -> image {
+    using namespace std::string_literals;
+    std::ifstream file{filename, std::ios::binary};
+    if (!file) throw std::runtime_error("nrv::read_raw: error reading file: \""s + filename.string() + "\""s);
+    auto const header = parse_header("nrv::read_raw", file, filename);
+    file.seekg(static_cast<std::streamoff>(header.offset));
+
+    image output{header.width, header.height, header.channels};
+    auto const packed = row_bytes(header.width, header.channels);
+    auto crc = 0u;
+    if (header.stride == packed) {
+        file.read(reinterpret_cast<char*>(output.buffer()), static_cast<std::streamsize>(header.payload_size));
+        if (verify) crc = crc32(as_bytes(output.buffer()), header.payload_size);
+    } else {
+        // Padded rows are read whole so the checksum covers the same bytes as on disk.
+        std::vector<char> row(header.stride);
+        for (std::int32_t y = 0; y < header.height; ++y) {
+            file.read(row.data(), static_cast<std::streamsize>(row.size()));
+            if (verify) crc = crc32(as_bytes(row.data()), row.size(), crc);
+            std::copy_n(row.data(), packed, reinterpret_cast<char*>(output.buffer()) + static_cast<std::size_t>(y) * packed);
+        }
+    }
+    if (!file) throw std::runtime_error("nrv::read_raw: error reading file: \""s + filename.string() + "\""s);
+    if (verify && crc != header.payload_crc)
+        throw std::runtime_error("nrv::read_raw: \""s + filename.string() + "\" payload checksum mismatch"s);
+    return output;
+}
+
+mapped_image::mapped_image(std::filesystem::path const& filename, bool const& verify) {
+    using namespace std::string_literals;
+    auto const header = read_raw_header(filename);
+    if (header.stride != row_bytes(header.width, header.channels)) {
+        m_image = read_raw(filename, verify);
+        return;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    auto const descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (descriptor < 0) throw std::runtime_error("nrv::mapped_image: error opening file: \""s + filename.string() + "\""s);
+    auto const length = static_cast<std::size_t>(header.offset + header.payload_size);
+    auto* mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) throw std::runtime_error("nrv::mapped_image: error mapping file: \""s + filename.string() + "\""s);
+    m_mapping = mapping;
+    m_length  = length;
+
+    auto* pixels = static_cast<std::uint8_t*>(mapping) + header.offset;
+    if (verify && crc32(pixels, header.payload_size) != header.payload_crc) {
+        unmap();
+        throw std::runtime_error("nrv::mapped_image: \""s + filename.string() + "\" payload checksum mismatch"s);
+    }
+    m_image = image{header.width, header.height, header.channels, reinterpret_cast<float*>(pixels)};
+#else
+    m_image = read_raw(filename, verify);
+#endif
+}
+
+mapped_image::mapped_image(mapped_image&& other) noexcept
+    : m_mapping(std::exchange(other.m_mapping, nullptr)), m_length(std::exchange(other.m_length, 0))
+    , m_image(std::move(other.m_image)) {}
+
+mapped_image::~mapped_image() {
+    unmap();
+}
+
+auto mapped_image::operator=(mapped_image&& other) noexcept -> mapped_image& {
+    if (this == &other) return *this;
+    unmap();
+    m_mapping = std::exchange(other.m_mapping, nullptr);
+    m_length  = std::exchange(other.m_length, 0);
+    m_image   = std::move(other.m_image);
+    return *this;
+}
+
+auto mapped_image::unmap() -> void {
+#if defined(__unix__) || defined(__APPLE__)
+    if (m_mapping != nullptr) ::munmap(m_mapping, m_length);
+#endif
+    m_mapping = nullptr;
+    m_length  = 0;
+}
+}
@@ -0,0 +1,105 @@
+/**
+ * @file   raw.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Native uncompressed image format that can be memory mapped
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_RAW_HPP
+#define IMAGEPP_RAW_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "image.hpp"
+
+namespace nrv {
+enum class raw_type : std::uint32_t {
+    f32 = 1,  // 32-bit little-endian IEEE float
+};
+
+/**
+ * Fixed 64 byte header at the start of a .nrv file. The payload starts at offset, a multiple of
+ * raw_alignment, and holds height rows of stride bytes. All fields are little-endian.
+ */
+struct raw_header {
+    std::array<char, 8> magic{'n', 'r', 'v', 'i', 'm', 'a', 'g', 'e'};
+    std::uint32_t version{1};
+    raw_type      type{raw_type::f32};
+    std::int32_t  width{0};
+    std::int32_t  height{0};
+    std::int32_t  channels{0};
+    std::uint32_t payload_crc{0};   // CRC-32 of the payload
+    std::uint64_t stride{0};        // Bytes per row, at least width * channels * 4
+    std::uint64_t offset{0};        // Byte offset of the payload from the start of the file
+    std::uint64_t payload_size{0};  // height * stride
+    std::uint32_t header_crc{0};    // CRC-32 of the preceding header bytes
+    std::uint32_t reserved{0};
+};
+static_assert(sizeof(raw_header) == 64);
+
+inline constexpr std::size_t raw_alignment = 64;
+
+/**
+ * Write the header and the float buffer as is, no conversion or compression.
+ * @throws std::runtime_error when the file can not be written.
+ */
+auto write_raw(std::filesystem::path const& filename, image const& img) -> void;
+
+/**
+ * Read the header and check its magic, version, type, sizes and checksum.
+ * @throws std::runtime_error when the file is not a valid .nrv image.
+ */
+auto read_raw_header(std::filesystem::path const& filename) -> raw_header;
+
+/**
+ * Read a .nrv file into an owned image.
+ * @param verify Check the payload checksum.
+ * @throws std::runtime_error when the file is invalid or the payload checksum differs.
+ */
+auto read_raw(std::filesystem::path const& filename, bool const& verify = true) -> image;
+
+/**
+ * A .nrv file mapped into memory, the pixels are used in place without being read or converted.
+ * The mapping is private, writes through a view stay in memory and never reach the file. Files with
+ * padded rows and platforms without mmap fall back to reading into an owned buffer.
+ */
+class mapped_image {
+  public:
+    /**
+     * @param verify Check the payload checksum, this touches every page of the file.
+     * @throws std::runtime_error when the file is invalid or can not be mapped.
+     */
+    explicit mapped_image(std::filesystem::path const& filename, bool const& verify = false);
+    mapped_image(mapped_image const&) = delete;
+    mapped_image(mapped_image&& other) noexcept;
+    ~mapped_image();
+
+    auto operator=(mapped_image const&) -> mapped_image& = delete;
+    auto operator=(mapped_image&& other) noexcept -> mapped_image&;
+
+    auto width()     const -> std::int32_t { return m_image.width(); }
+    auto height()    const -> std::int32_t { return m_image.height(); }
+    auto channels()  const -> std::int32_t { return m_image.channels(); }
+    auto buffer()    const -> float*       { return m_image.buffer(); }
+    auto is_mapped() const -> bool         { return m_mapping != nullptr; }
+
+    /**
+     * Non-owning image over the pixels, valid while this mapped_image is alive.
+     */
+    auto view() const -> image { return {m_image.width(), m_image.height(), m_image.channels(), m_image.buffer()}; }
+
+  private:
+    auto unmap() -> void;
+
+  private:
+    void*       m_mapping{nullptr};
+    std::size_t m_length{0};
+    image       m_image{0, 0, 0, nullptr};
+};
+}
+
+#endif  // IMAGEPP_RAW_HPP
@@ -0,0 +1,240 @@
+/**
+ * @file   resample.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Separable image resampling
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "resample.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+constexpr std::int32_t band_height = 32;
+
+auto support_of(resample_filter const& filter) -> float {
+    switch (filter) {
+        case resample_filter::bilinear: return 1.0f;
+        case resample_filter::bicubic:  return 2.0f;
+        case resample_filter::mitchell: return 2.0f;
+        case resample_filter::lanczos3: return 3.0f;
+        case resample_filter::area:     return 0.5f;
+    }
+    return 1.0f;
+}
+
+auto cubic(float const& x, float const& b, float const& c) -> float {
+    auto const t = std::abs(x);
+    if (t < 1.0f)
+        return ((12.0f - 9.0f * b - 6.0f * c) * t * t * t + (-18.0f + 12.0f * b + 6.0f * c) * t * t + (6.0f - 2.0f * b)) / 6.0f;
+    if (t < 2.0f)
+        return ((-b - 6.0f * c) * t * t * t + (6.0f * b + 30.0f * c) * t * t + (-12.0f * b - 48.0f * c) * t + (8.0f * b + 24.0f * c)) / 6.0f;
+    return 0.0f;
+}
+
+auto sinc(float const& x) -> float {
+    if (std::abs(x) < 1e-6f) return 1.0f;
+    auto const px = std::numbers::pi_v<float> * x;
+    return std::sin(px) / px;
+}
+
+auto kernel(resample_filter const& filter, float const& x) -> float {
+    switch (filter) {
+        case resample_filter::bilinear: return std::max(0.0f, 1.0f - std::abs(x));
+        case resample_filter::bicubic:  return cubic(x, 0.0f, 0.5f);
+        case resample_filter::mitchell: return cubic(x, 1.0f / 3.0f, 1.0f / 3.0f);
+        case resample_filter::lanczos3: return std::abs(x) < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+        case resample_filter::area:     return 0.0f;
+    }
+    return 0.0f;
+}
+
+auto row_of(image const& img, std::int32_t const& y) -> float* {
+    return img.buffer() + static_cast<std::size_t>(y) * static_cast<std::size_t>(img.width() * img.channels());
+}
+}
+
+resample_weights::resample_weights(std::int32_t const& source_size, std::int32_t const& target_size, resample_filter const& filter,
+                                   std::int32_t const& first, std::int32_t const& size) {
+    if (source_size < 1 || target_size < 1) throw std::invalid_argument("nrv::resample_weights: sizes must be positive");
+    auto const kept = size < 0 ? target_size - first : size;
+    if (first < 0 || kept < 0 || first + kept > target_size)
+        throw std::invalid_argument("nrv::resample_weights: kept range outside the target");
+
+    auto const ratio   = static_cast<float>(source_size) / static_cast<float>(target_size);
+    auto const scale   = std::max(ratio, 1.0f);
+    auto const support = support_of(filter) * scale;
+    taps = static_cast<std::int32_t>(std::ceil(support)) * 2 + 2;
+    start.resize(static_cast<std::size_t>(kept));
+    count.resize(static_cast<std::size_t>(kept));
+    weights.assign(static_cast<std::size_t>(kept * taps), 0.0f);
+
+    for (std::int32_t i = 0; i < kept; ++i) {
+        auto const center = (static_cast<float>(first + i) + 0.5f) * ratio;  // in source pixel edges
+        auto const lo = static_cast<std::int32_t>(std::floor(center - support));
+        auto const hi = static_cast<std::int32_t>(std::ceil(center + support));
+        auto const left  = std::clamp(lo, 0, source_size - 1);
+        auto const right = std::clamp(hi, 0, source_size - 1);
+        auto* w = weights.data() + i * taps;
+
+        auto total = 0.0f;
+        for (auto k = lo; k <= hi; ++k) {
+            float value;
+            if (filter == resample_filter::area) {
+                // Overlap of source pixel [k, k + 1) with the output pixel footprint.
+                auto const a = std::max(static_cast<float>(k), center - ratio * 0.5f);
+                auto const b = std::min(static_cast<float>(k + 1), center + ratio * 0.5f);
+                value = std::max(0.0f, b - a);
+            } else {
+                value = kernel(filter, (static_cast<float>(k) + 0.5f - center) / scale);
+            }
+            w[std::clamp(k, 0, source_size - 1) - left] += value;
+            total += value;
+        }
+        if (total != 0.0f)
+            for (std::int32_t k = 0; k <= right - left; ++k) w[k] /= total;
+
+        start[static_cast<std::size_t>(i)] = left;
+        count[static_cast<std::size_t>(i)] = right - left + 1;
+    }
+}
+
+auto resample(image const& source, image& destination, resample_weights const& columns, resample_weights const& rows,
+              std::int32_t const& x, std::int32_t const& y) -> void {
+    auto const to_grey = destination.channels() == 1 && source.channels() >= 3;
+    if (destination.channels() != source.channels() && !to_grey)
+        throw std::invalid_argument("nrv::resample: destination must have the source channels or a single channel");
+    if (source.buffer() == destination.buffer())
+        throw std::invalid_argument("nrv::resample: source and destination must be different images");
+    if (x < 0 || y < 0 || x + columns.size() > destination.width() || y + rows.size() > destination.height())
+        throw std::invalid_argument("nrv::resample: target rectangle outside the destination");
+
+    auto const in_channels = source.channels();
+    auto const channels    = destination.channels();
+    auto const out_width   = columns.size();
+    auto const row_size    = out_width * channels;
+    auto const bands       = (rows.size() + band_height - 1) / band_height;
+
+    parallel_for(bands, [&](std::int32_t const& band) {
+        auto const y0 = band * band_height;
+        auto const y1 = std::min(y0 + band_height, rows.size());
+        auto const first = rows.start[static_cast<std::size_t>(y0)];
+        auto last = first;
+        for (auto i = y0; i < y1; ++i)
+            last = std::max(last, rows.start[static_cast<std::size_t>(i)] + rows.count[static_cast<std::size_t>(i)]);
+
+        // Horizontal pass over every source row the band touches.
+        std::vector<float> cache(static_cast<std::size_t>((last - first) * row_size));
+        std::vector<float> grey(to_grey ? static_cast<std::size_t>(source.width()) : 0);
+        for (auto sy = first; sy < last; ++sy) {
+            auto const* in = row_of(source, sy);
+            if (to_grey) {
+                for (std::int32_t j = 0; j < source.width(); ++j) {
+                    auto const* p = in + j * in_channels;
+                    grey.data()[j] = 0.2126f * p[0] + 0.7152f * p[1] + 0.0722f * p[2];
+                }
+                in = grey.data();
+            }
+            auto* out = cache.data() + (sy - first) * row_size;
+            for (std::int32_t j = 0; j < out_width; ++j) {
+                auto const* w  = columns.weights.data() + j * columns.taps;
+                auto const* px = in + columns.start[static_cast<std::size_t>(j)] * channels;
+                auto const n   = columns.count[static_cast<std::size_t>(j)];
+                auto* o = out + j * channels;
+                std::fill_n(o, channels, 0.0f);
+                for (std::int32_t k = 0; k < n; ++k)
+                    for (std::int32_t c = 0; c < channels; ++c) o[c] += w[k] * px[k * channels + c];
+            }
+        }
+
+        // Vertical pass, weighted sums of whole cached rows.
+        for (auto i = y0; i < y1; ++i) {
+            auto const* w = rows.weights.data() + i * rows.taps;
+            auto const s  = rows.start[static_cast<std::size_t>(i)];
+            auto const n  = rows.count[static_cast<std::size_t>(i)];
+            auto* out = row_of(destination, y + i) + x * channels;
+            std::fill_n(out, row_size, 0.0f);
+            for (std::int32_t k = 0; k < n; ++k) {
+                auto const weight = w[k];
+                auto const* in = cache.data() + (s + k - first) * row_size;
+                for (std::int32_t j = 0; j < row_size; ++j) out[j] += weight * in[j];
+            }
+        }
+    });
+}
+
+auto resize(image const& source, image& destination, resample_filter const& filter) -> void {
+    // Exact integer reductions with the area filter are plain block means.
+    if (filter == resample_filter::area && destination.channels() == source.channels() &&
+        destination.width() > 0 && destination.height() > 0 && source.width() % destination.width() == 0 && source.height() % destination.height() == 0 &&
+        source.width() / destination.width() == source.height() / destination.height()) {
+        downscale(source, destination, source.width() / destination.width());
+        return;
+    }
+
+    resample_weights const columns{source.width(), destination.width(), filter};
+    resample_weights const rows{source.height(), destination.height(), filter};
+    resample(source, destination, columns, rows);
+}
+
+auto resize(image const& source, std::int32_t const& width, std::int32_t const& height, resample_filter const& filter) -> image {
+    image output{width, height, source.channels()};
+    resize(source, output, filter);
+    return output;
+}
+
+auto downscale(image const& source, image& destination, std::int32_t const& factor) -> void {
+    if (factor < 1) throw std::invalid_argument("nrv::downscale: factor must be positive");
+    if (destination.width() != (source.width() + factor - 1) / factor ||
+        destination.height() != (source.height() + factor - 1) / factor ||
+        destination.channels() != source.channels())
+        throw std::invalid_argument("nrv::downscale: destination must be the source size divided by factor");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+    auto const row_size = width * channels;
+
+    parallel_for_range(destination.height(), 4, [&](std::int32_t const& begin, std::int32_t const& end) {
+        std::vector<float> acc(static_cast<std::size_t>(row_size));
+        for (auto y = begin; y < end; ++y) {
+            auto const r0 = y * factor;
+            auto const r1 = std::min(r0 + factor, height);
+            auto* sum = acc.data();
+            std::copy_n(row_of(source, r0), row_size, sum);
+            for (auto r = r0 + 1; r < r1; ++r) {
+                auto const* in = row_of(source, r);
+                for (std::int32_t j = 0; j < row_size; ++j) sum[j] += in[j];
+            }
+
+            auto* out = row_of(destination, y);
+            for (std::int32_t x = 0; x < destination.width(); ++x) {
+                auto const c0 = x * factor;
+                auto const c1 = std::min(c0 + factor, width);
+                auto const scale = 1.0f / static_cast<float>((c1 - c0) * (r1 - r0));
+                auto const* block = sum + c0 * channels;
+                auto* o = out + x * channels;
+                for (std::int32_t c = 0; c < channels; ++c) {
+                    auto total = 0.0f;
+                    for (std::int32_t k = 0; k < c1 - c0; ++k) total += block[k * channels + c];
+                    o[c] = total * scale;
+                }
+            }
+        }
+    });
+}
+
+auto downscale(image const& source, std::int32_t const& factor) -> image {
+    if (factor < 1) throw std::invalid_argument("nrv::downscale: factor must be positive");
+    image output{(source.width() + factor - 1) / factor, (source.height() + factor - 1) / factor, source.channels()};
+    downscale(source, output, factor);
+    return output;
+}
+}
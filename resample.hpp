@@ -0,0 +1,83 @@
+/**
+ * @file   resample.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Separable image resampling
+ *         https://en.wikipedia.org/wiki/Image_scaling
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_RESAMPLE_HPP
+#define IMAGEPP_RESAMPLE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "image.hpp"
+
+namespace nrv {
+enum class resample_filter {
+    bilinear,
+    bicubic,   // Keys cubic, a = -0.5
+    mitchell,  // Mitchell-Netravali, B = C = 1/3
+    lanczos3,
+    area,      // exact pixel coverage, best for reduction
+};
+
+/**
+ * Precomputed weights for resampling one axis. Output index i reads the contiguous source range
+ * [start[i], start[i] + count[i]) with weights at weights[i * taps], edges are clamped and normalised.
+ */
+struct resample_weights {
+    std::int32_t              taps{0};
+    std::vector<std::int32_t> start{};
+    std::vector<std::int32_t> count{};
+    std::vector<float>        weights{};
+
+    /**
+     * @param source_size Source length along the axis.
+     * @param target_size Length the source is scaled to.
+     * @param filter      Reconstruction filter.
+     * @param first       First target index to keep, lets a crop skip the weights it never uses.
+     * @param size        Number of target indices to keep, -1 keeps everything from first on.
+     */
+    resample_weights(std::int32_t const& source_size, std::int32_t const& target_size, resample_filter const& filter,
+                     std::int32_t const& first = 0, std::int32_t const& size = -1);
+
+    auto size() const -> std::int32_t { return static_cast<std::int32_t>(start.size()); }
+};
+
+/**
+ * Resample source into the columns.size() x rows.size() rectangle of destination at (x, y).
+ * This is the pass behind resize, exposed so fitting and cropping can write into part of a frame.
+ */
+auto resample(image const& source, image& destination, resample_weights const& columns, resample_weights const& rows,
+              std::int32_t const& x = 0, std::int32_t const& y = 0) -> void;
+
+/**
+ * Resize to the destination size. Rows are resampled horizontally with precomputed weights and cached per
+ * row band, the vertical pass then combines whole cached rows. Bands run in parallel.
+ * A single channel destination from a source with 3 or more channels converts to Rec.709 luminance
+ * before the horizontal pass, so resize and greyscale conversion share one pass.
+ * @param source      Image to resample.
+ * @param destination Output with the target size, same channels as source or 1.
+ * @param filter      Reconstruction filter.
+ */
+auto resize(image const& source, image& destination, resample_filter const& filter = resample_filter::lanczos3) -> void;
+auto resize(image const& source, std::int32_t const& width, std::int32_t const& height,
+            resample_filter const& filter = resample_filter::lanczos3) -> image;
+
+/**
+ * Reduce by an integer factor, every output pixel is the mean of a factor x factor block.
+ * One streaming pass: the block rows are summed into an accumulator row and then reduced across the
+ * block columns, output row bands run in parallel. Blocks on the right and bottom edge that stick out
+ * of the source average the pixels they cover.
+ * @param source      Image to reduce.
+ * @param destination Output of ((width + factor - 1) / factor, (height + factor - 1) / factor), same channels.
+ * @param factor      Reduction factor.
+ */
+auto downscale(image const& source, image& destination, std::int32_t const& factor) -> void;
+auto downscale(image const& source, std::int32_t const& factor) -> image;
+}
+
+#endif  // IMAGEPP_RESAMPLE_HPP
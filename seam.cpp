@@ -0,0 +1,213 @@
+/**
+ * @file   seam.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Content aware resizing with seam carving
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "seam.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+constexpr float infinity = std::numeric_limits<float>::infinity();
+
+/**
+ * Working state for removing vertical seams. Rows keep their original stride while the used width shrinks.
+ */
+struct carver {
+    std::int32_t width;
+    std::int32_t height;
+    std::int32_t stride;
+    std::int32_t channels;
+    std::vector<float> pixels;
+    std::vector<float> luma;
+    std::vector<float> energy;
+    std::vector<float> cost;       // cumulative cost, one padded row of stride + 2 per image row
+    std::vector<std::uint8_t> removed;
+    std::vector<std::int32_t> holes;  // new column of every pixel removed in a pass, batch per row
+
+    carver(image const& source, bool const& transpose)
+        : width(transpose ? source.height() : source.width())
+        , height(transpose ? source.width() : source.height())
+        , stride(width), channels(source.channels())
+        , pixels(source.size()), luma(static_cast<std::size_t>(width * height))
+        , energy(luma.size()), cost(static_cast<std::size_t>((stride + 2) * height))
+        , removed(luma.size(), 0) {
+        auto const sw = source.width();
+        parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+            for (auto y = begin; y < end; ++y) {
+                for (std::int32_t x = 0; x < width; ++x) {
+                    auto const sx = transpose ? y : x;
+                    auto const sy = transpose ? x : y;
+                    auto const* in = source.buffer() + (static_cast<std::ptrdiff_t>(sy) * sw + sx) * channels;
+                    auto* out = pixel(x, y);
+                    std::copy_n(in, channels, out);
+                    luma[index(x, y)] = channels >= 3 ? 0.2126f * in[0] + 0.7152f * in[1] + 0.0722f * in[2] : in[0];
+                }
+            }
+        });
+        parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+            for (auto y = begin; y < end; ++y)
+                for (std::int32_t x = 0; x < width; ++x) update_energy(x, y);
+        });
+    }
+
+    auto index(std::int32_t const& x, std::int32_t const& y) const -> std::size_t {
+        return static_cast<std::size_t>(y) * static_cast<std::size_t>(stride) + static_cast<std::size_t>(x);
+    }
+    auto pixel(std::int32_t const& x, std::int32_t const& y) -> float* {
+        return pixels.data() + static_cast<std::ptrdiff_t>(index(x, y)) * channels;
+    }
+
+    auto update_energy(std::int32_t const& x, std::int32_t const& y) -> void {
+        if (x < 0 || x >= width) return;
+        auto const l = luma[index(std::max(x - 1, 0), y)];
+        auto const r = luma[index(std::min(x + 1, width - 1), y)];
+        auto const u = luma[index(x, std::max(y - 1, 0))];
+        auto const d = luma[index(x, std::min(y + 1, height - 1))];
+        energy[index(x, y)] = std::abs(r - l) + std::abs(d - u);
+    }
+
+    /**
+     * Cumulative minimum cost, rows are padded with infinity so the three way minimum needs no branches.
+     */
+    auto accumulate() -> void {
+        auto const padded = stride + 2;
+        auto* c = cost.data();
+        c[0] = infinity;
+        for (std::int32_t x = 0; x < width; ++x) c[x + 1] = energy[index(x, 0)];
+        c[width + 1] = infinity;
+        for (std::int32_t y = 1; y < height; ++y) {
+            auto const* prev = c + (y - 1) * padded;
+            auto* row = c + y * padded;
+            auto const* e = energy.data() + index(0, y);
+            row[0] = infinity;
+            for (std::int32_t x = 0; x < width; ++x)
+                row[x + 1] = e[x] + std::min(std::min(prev[x], prev[x + 1]), prev[x + 2]);
+            row[width + 1] = infinity;
+        }
+    }
+
+    /**
+     * Trace seams back from the cheapest bottom cells, seams that would reuse a pixel are dropped.
+     * @return Number of seams marked for removal.
+     */
+    auto mark(std::int32_t const& count) -> std::int32_t {
+        auto const padded = stride + 2;
+        auto const* last = cost.data() + (height - 1) * padded + 1;
+        std::vector<std::int32_t> order(static_cast<std::size_t>(width));
+        std::iota(order.begin(), order.end(), 0);
+        auto const candidates = std::min(width, count * 4);
+        std::partial_sort(order.begin(), order.begin() + candidates, order.end(),
+                          [&](std::int32_t const& a, std::int32_t const& b) { return last[a] < last[b]; });
+
+        std::vector<std::int32_t> path(static_cast<std::size_t>(height));
+        std::int32_t marked = 0;
+        for (std::int32_t i = 0; i < candidates && marked < count; ++i) {
+            auto x = order[static_cast<std::size_t>(i)];
+            auto clear = true;
+            for (auto y = height - 1; y >= 0; --y) {
+                if (removed[index(x, y)]) {
+                    clear = false;
+                    break;
+                }
+                path[static_cast<std::size_t>(y)] = x;
+                if (y == 0) break;
+                auto const* prev = cost.data() + (y - 1) * padded + 1;
+                auto best = x;
+                if (x > 0 && prev[x - 1] < prev[best]) best = x - 1;
+                if (x + 1 < width && prev[x + 1] < prev[best]) best = x + 1;
+                x = best;
+            }
+            if (!clear) continue;
+            for (std::int32_t y = 0; y < height; ++y) removed[index(path[static_cast<std::size_t>(y)], y)] = 1;
+            ++marked;
+        }
+        return marked;
+    }
+
+    /**
+     * Compact every row past the marked pixels, then refresh the energy next to the holes.
+     */
+    auto remove(std::int32_t const& marked) -> void {
+        holes.assign(static_cast<std::size_t>(height * marked), 0);
+        parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+            for (auto y = begin; y < end; ++y) {
+                std::int32_t write = 0;
+                std::int32_t hole  = 0;
+                for (std::int32_t x = 0; x < width; ++x) {
+                    if (removed[index(x, y)]) {
+                        removed[index(x, y)] = 0;
+                        holes[static_cast<std::size_t>(y * marked + hole++)] = write;
+                        continue;
+                    }
+                    if (write != x) {
+                        std::copy_n(pixel(x, y), channels, pixel(write, y));
+                        luma[index(write, y)]   = luma[index(x, y)];
+                        energy[index(write, y)] = energy[index(x, y)];
+                    }
+                    ++write;
+                }
+            }
+        });
+        width -= marked;
+
+        // A removed pixel changes the horizontal neighbours in its row and, since seams move at most one
+        // column per row, the vertical neighbours within two columns in the rows above and below.
+        parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+            for (auto y = begin; y < end; ++y) {
+                for (std::int32_t k = 0; k < marked; ++k) {
+                    auto const p = holes[static_cast<std::size_t>(y * marked + k)];
+                    for (auto x = p - 2; x <= p + 1; ++x) update_energy(x, y);
+                }
+            }
+        });
+    }
+
+    auto to_image(bool const& transpose) -> image {
+        image output{transpose ? height : width, transpose ? width : height, channels};
+        parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+            for (auto y = begin; y < end; ++y) {
+                for (std::int32_t x = 0; x < width; ++x) {
+                    auto const ox = transpose ? y : x;
+                    auto const oy = transpose ? x : y;
+                    std::copy_n(pixel(x, y), channels, output.buffer() + (static_cast<std::ptrdiff_t>(oy) * output.width() + ox) * channels);
+                }
+            }
+        });
+        return output;
+    }
+};
+
+auto carve_width(image const& source, std::int32_t const& target, std::int32_t const& batch, bool const& transpose) -> image {
+    carver state{source, transpose};
+    while (state.width > target) {
+        auto const remaining = state.width - target;
+        auto const count = std::min(remaining, batch > 0 ? batch : std::max(1, state.width / 16));
+        state.accumulate();
+        state.remove(state.mark(count));
+    }
+    return state.to_image(transpose);
+}
+}
+
+auto seam_carve(image const& source, std::int32_t const& width, std::int32_t const& height, std::int32_t const& batch) -> image {
+    if (width < 1 || height < 1 || width > source.width() || height > source.height())
+        throw std::invalid_argument("nrv::seam_carve: target must be positive and no larger than the source");
+    if (batch < 0) throw std::invalid_argument("nrv::seam_carve: batch must not be negative");
+
+    auto narrowed = carve_width(source, width, batch, false);
+    if (height == source.height()) return narrowed;
+    return carve_width(narrowed, height, batch, true);
+}
+}
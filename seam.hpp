@@ -0,0 +1,31 @@
+/**
+ * @file   seam.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Content aware resizing with seam carving
+ *         Avidan & Shamir, Seam Carving for Content-Aware Image Resizing, 2007
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_SEAM_HPP
+#define IMAGEPP_SEAM_HPP
+
+#include <cstdint>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * Shrink to the target size by repeatedly removing the connected seams with the least gradient energy.
+ * Each pass runs one dynamic programming sweep over rows, the sweep is a branch free loop across the
+ * columns of a row, and then removes up to `batch` seams that share no pixel. Energy is only recomputed
+ * next to removed pixels. Heights are reduced the same way on the transposed image.
+ * @param source Image to shrink.
+ * @param width  Target width, at most the source width.
+ * @param height Target height, at most the source height.
+ * @param batch  Seams removed per pass, 0 picks about 1/16th of the current size.
+ */
+auto seam_carve(image const& source, std::int32_t const& width, std::int32_t const& height, std::int32_t const& batch = 0) -> image;
+}
+
+#endif  // IMAGEPP_SEAM_HPP
@@ -0,0 +1,158 @@
+/**
+ * @file   threshold.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Global and adaptive binarisation
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "threshold.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "integral.hpp"
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+auto luminance(float const* pixel, std::int32_t const& channels) -> float {
+    return channels >= 3 ? 0.2126f * pixel[0] + 0.7152f * pixel[1] + 0.0722f * pixel[2] : pixel[0];
+}
+
+auto write_binary(float* out, float const* in, std::int32_t const& channels, bool const& set) -> void {
+    auto const colour = colour_channels(channels);
+    for (std::int32_t c = 0; c < colour; ++c) out[c] = set ? 1.0f : 0.0f;
+    for (auto c = colour; c < channels; ++c) out[c] = in[c];
+}
+
+// Shared driver of the adaptive methods, level_fn maps the window mean, mean of squares and the pixel to on or off.
+template <typename level_fn_t>
+auto adaptive_threshold(char const* name, image const& source, image& destination, std::int32_t const& radius,
+                        bool const& squares, level_fn_t const& level_fn) -> void {
+    if (radius < 0) throw std::invalid_argument(std::string(name) + ": radius must not be negative");
+    if (source.buffer() == destination.buffer())
+        throw std::invalid_argument(std::string(name) + ": source and destination must be different images");
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument(std::string(name) + ": source and destination dimensions differ");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+
+    // Luminance, plus its square when the method needs the deviation.
+    auto const packed = squares ? 2 : 1;
+    image moments{width, height, packed};
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto p = static_cast<std::size_t>(begin) * static_cast<std::size_t>(width); p < static_cast<std::size_t>(end) * static_cast<std::size_t>(width); ++p) {
+            auto const luma = luminance(source.buffer() + p * static_cast<std::size_t>(channels), channels);
+            auto* m = moments.buffer() + p * static_cast<std::size_t>(packed);
+            m[0] = luma;
+            if (squares) m[1] = luma * luma;
+        }
+    });
+    integral_image const table{moments};
+
+    parallel_for_range(height, 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const y0 = std::max(y - radius, 0);
+            auto const y1 = std::min(y + radius + 1, height);
+            auto const offset = static_cast<std::size_t>(y) * static_cast<std::size_t>(width);
+            auto const* m  = moments.buffer() + offset * static_cast<std::size_t>(packed);
+            auto const* in = source.buffer() + offset * static_cast<std::size_t>(channels);
+            auto* out = destination.buffer() + offset * static_cast<std::size_t>(channels);
+            for (std::int32_t x = 0; x < width; ++x) {
+                auto const x0 = std::max(x - radius, 0);
+                auto const x1 = std::min(x + radius + 1, width);
+                auto const n  = static_cast<double>((x1 - x0) * (y1 - y0));
+                auto const mean   = table.sum(x0, y0, x1, y1, 0) / n;
+                auto const square = squares ? table.sum(x0, y0, x1, y1, 1) / n : 0.0;
+                write_binary(out + x * channels, in + x * channels, channels,
+                             level_fn(static_cast<double>(m[x * packed]), mean, square));
+            }
+        }
+    });
+}
+}
+
+auto otsu_threshold(histogram const& hist, std::int32_t const& channel) -> float {
+    auto const bins   = hist.bins();
+    auto const* count = hist.counts(channel);
+    double total = 0.0, weighted = 0.0;
+    for (std::int32_t i = 0; i < bins; ++i) {
+        total    += static_cast<double>(count[i]);
+        weighted += static_cast<double>(i) * static_cast<double>(count[i]);
+    }
+    if (total == 0.0) return 0.5f;
+
+    double background = 0.0, background_sum = 0.0, best = -1.0;
+    std::int32_t level = 0;
+    for (std::int32_t i = 0; i < bins - 1; ++i) {
+        background     += static_cast<double>(count[i]);
+        background_sum += static_cast<double>(i) * static_cast<double>(count[i]);
+        auto const foreground = total - background;
+        if (background == 0.0 || foreground == 0.0) continue;
+        auto const difference = background_sum / background - (weighted - background_sum) / foreground;
+        auto const between    = background * foreground * difference * difference;
+        if (between > best) {
+            best  = between;
+            level = i;
+        }
+    }
+    // Bin i collects values around i / (bins - 1), the split lies halfway to the next bin.
+    return (static_cast<float>(level) + 0.5f) / static_cast<float>(bins - 1);
+}
+
+auto otsu_threshold(image const& source) -> float {
+    return otsu_threshold(compute_luminance_histogram(source));
+}
+
+auto threshold(image const& source, image& destination, float const& level) -> void {
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::threshold: source and destination dimensions differ");
+    auto const width    = source.width();
+    auto const channels = source.channels();
+    parallel_for_range(source.height(), 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto p = static_cast<std::size_t>(begin) * static_cast<std::size_t>(width); p < static_cast<std::size_t>(end) * static_cast<std::size_t>(width); ++p) {
+            auto const* in = source.buffer() + p * static_cast<std::size_t>(channels);
+            write_binary(destination.buffer() + p * static_cast<std::size_t>(channels), in, channels,
+                         luminance(in, channels) >= level);
+        }
+    });
+}
+
+auto bradley_threshold(image const& source, image& destination, std::int32_t const& radius, float const& k) -> void {
+    auto const scale = 1.0 - static_cast<double>(k);
+    adaptive_threshold("nrv::bradley_threshold", source, destination, radius, false,
+                       [scale](double const& value, double const& mean, double const&) {
+        return value >= mean * scale;
+    });
+}
+
+auto bradley_threshold(image const& source, std::int32_t const& radius, float const& k) -> image {
+    image destination{source.width(), source.height(), source.channels()};
+    bradley_threshold(source, destination, radius, k);
+    return destination;
+}
+
+auto sauvola_threshold(image const& source, image& destination, std::int32_t const& radius, float const& k) -> void {
+    // Dynamic range of the deviation, half the value range.
+    constexpr double range = 0.5;
+    auto const sensitivity = static_cast<double>(k);
+    adaptive_threshold("nrv::sauvola_threshold", source, destination, radius, true,
+                       [sensitivity](double const& value, double const& mean, double const& square) {
+        auto const deviation = std::sqrt(std::max(square - mean * mean, 0.0));
+        return value >= mean * (1.0 + sensitivity * (deviation / range - 1.0));
+    });
+}
+
+auto sauvola_threshold(image const& source, std::int32_t const& radius, float const& k) -> image {
+    image destination{source.width(), source.height(), source.channels()};
+    sauvola_threshold(source, destination, radius, k);
+    return destination;
+}
+}
@@ -0,0 +1,61 @@
+/**
+ * @file   threshold.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Global and adaptive binarisation
+ *         https://en.wikipedia.org/wiki/Otsu%27s_method
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_THRESHOLD_HPP
+#define IMAGEPP_THRESHOLD_HPP
+
+#include <cstdint>
+
+#include "image.hpp"
+#include "histogram.hpp"
+
+namespace nrv {
+/**
+ * Otsu threshold of one histogram channel, the level that maximises the variance between the two classes.
+ * @return Level in [0, 1], values below it belong to the dark class.
+ */
+auto otsu_threshold(histogram const& hist, std::int32_t const& channel = 0) -> float;
+
+/**
+ * Otsu threshold of the luminance of an image, computed from a single histogram pass.
+ */
+auto otsu_threshold(image const& source) -> float;
+
+/**
+ * Binarise the luminance against a fixed level, colour channels become 0.0 or 1.0 and alpha is copied.
+ * @param source      Image to binarise.
+ * @param destination Output, same dimensions as source, may be the source itself.
+ * @param level       Values below the level become 0.0.
+ */
+auto threshold(image const& source, image& destination, float const& level) -> void;
+
+/**
+ * Bradley adaptive threshold, a pixel is dark when it is more than k below the mean of its window.
+ * Window sums come from a summed-area table so the cost per pixel does not depend on the radius.
+ * @param source      Image to binarise.
+ * @param destination Output, same dimensions as source, must not be the source.
+ * @param radius      Window radius, roughly the size of the largest glyph stroke to keep.
+ * @param k           Relative offset below the local mean.
+ */
+auto bradley_threshold(image const& source, image& destination, std::int32_t const& radius = 15, float const& k = 0.15f) -> void;
+auto bradley_threshold(image const& source, std::int32_t const& radius = 15, float const& k = 0.15f) -> image;
+
+/**
+ * Sauvola adaptive threshold, the level is mean * (1 + k * (deviation / 0.5 - 1)) over the window,
+ * so flat background is pushed to white and low contrast text survives.
+ * @param source      Image to binarise.
+ * @param destination Output, same dimensions as source, must not be the source.
+ * @param radius      Window radius.
+ * @param k           Sensitivity to the local deviation.
+ */
+auto sauvola_threshold(image const& source, image& destination, std::int32_t const& radius = 15, float const& k = 0.34f) -> void;
+auto sauvola_threshold(image const& source, std::int32_t const& radius = 15, float const& k = 0.34f) -> image;
+}
+
+#endif  // IMAGEPP_THRESHOLD_HPP
@@ -0,0 +1,74 @@
+/**
+ * @file   tile.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Tile based executor for neighbourhood filters
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "tile.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+
+namespace nrv {
+auto for_each_tile(image const& source, image& destination, std::int32_t const& halo, tile_fn_t const& fn,
+                   std::int32_t const& tile_size) -> void {
+    if (source.buffer() == destination.buffer())
+        throw std::invalid_argument("nrv::for_each_tile: source and destination must be different images");
+    if (source.width() != destination.width() || source.height() != destination.height() ||
+        source.channels() != destination.channels())
+        throw std::invalid_argument("nrv::for_each_tile: source and destination dimensions differ");
+    if (halo < 0 || tile_size < 1)
+        throw std::invalid_argument("nrv::for_each_tile: invalid halo or tile size");
+
+    auto const width    = source.width();
+    auto const height   = source.height();
+    auto const channels = source.channels();
+    auto const tiles_x  = (width  + tile_size - 1) / tile_size;
+    auto const tiles_y  = (height + tile_size - 1) / tile_size;
+
+    parallel_for(tiles_x * tiles_y, [&](std::int32_t const& index) {
+        thread_local std::vector<float> scratch{};
+
+        tile t{};
+        t.x        = (index % tiles_x) * tile_size;
+        t.y        = (index / tiles_x) * tile_size;
+        t.width    = std::min(tile_size, width  - t.x);
+        t.height   = std::min(tile_size, height - t.y);
+        t.halo     = halo;
+        t.channels = channels;
+
+        auto const in_width  = t.width  + 2 * halo;
+        auto const in_height = t.height + 2 * halo;
+        t.input_stride = in_width * channels;
+        scratch.resize(static_cast<std::size_t>(t.input_stride * in_height));
+
+        // Gather the tile with its halo, rows and columns outside the image repeat the edge.
+        auto const* src = source.buffer();
+        for (std::int32_t i = 0; i < in_height; ++i) {
+            auto const sy  = std::clamp(t.y + i - halo, 0, height - 1);
+            auto const* row = src + static_cast<std::size_t>(sy) * static_cast<std::size_t>(width * channels);
+            auto* dst = scratch.data() + i * t.input_stride;
+
+            auto const first = std::clamp(t.x - halo, 0, width);
+            auto const last  = std::clamp(t.x + t.width + halo, 0, width);
+            auto const left  = first - (t.x - halo);
+            for (std::int32_t j = 0; j < left; ++j)
+                std::copy_n(row, channels, dst + j * channels);
+            std::copy(row + first * channels, row + last * channels, dst + left * channels);
+            for (std::int32_t j = left + last - first; j < in_width; ++j)
+                std::copy_n(row + (width - 1) * channels, channels, dst + j * channels);
+        }
+
+        t.input         = scratch.data();
+        t.output_stride = width * channels;
+        t.output        = destination.buffer() + static_cast<std::size_t>(t.y) * static_cast<std::size_t>(t.output_stride)
+                        + t.x * channels;
+        fn(t);
+    });
+}
+}
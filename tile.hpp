@@ -0,0 +1,64 @@
+/**
+ * @file   tile.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Tile based executor for neighbourhood filters
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_TILE_HPP
+#define IMAGEPP_TILE_HPP
+
+#include <cstdint>
+#include <functional>
+
+#include "image.hpp"
+
+namespace nrv {
+/**
+ * One piece of work handed to a tile function.
+ *
+ * The input is a private copy of the source region [x - halo, x + width + halo) x [y - halo, y + height + halo),
+ * edges are clamped so filters never have to check bounds. The output points into the destination image at (x, y)
+ * and is owned exclusively by this tile.
+ */
+struct tile {
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t width;
+    std::int32_t height;
+    std::int32_t halo;
+    std::int32_t channels;
+
+    float const* input;
+    std::int32_t input_stride;  // floats per input row, includes both halos
+    float*       output;
+    std::int32_t output_stride; // floats per destination row
+
+    /**
+     * Input pixel in tile local coordinates, valid for [-halo, width + halo) x [-halo, height + halo).
+     */
+    auto in(std::int32_t const& px, std::int32_t const& py) const -> float const* {
+        return input + (py + halo) * input_stride + (px + halo) * channels;
+    }
+    auto out(std::int32_t const& px, std::int32_t const& py) const -> float* {
+        return output + py * output_stride + px * channels;
+    }
+};
+
+using tile_fn_t = std::function<void(tile const& t)>;
+
+/**
+ * Cut the destination into tiles, gather each tile with its halo and run fn on the worker pool.
+ * Every tile reads (tile_size + 2 * halo)^2 pixels, meant for kernels much smaller than a tile.
+ * @param source      Image to read from, must not share its buffer with destination.
+ * @param destination Image to write to, same dimensions as source.
+ * @param halo        Extra pixels on each side of the tile, the kernel radius.
+ * @param fn          Filter to run on every tile.
+ * @param tile_size   Tile edge length in pixels, picked so a tile with halo stays cache resident.
+ */
+auto for_each_tile(image const& source, image& destination, std::int32_t const& halo, tile_fn_t const& fn,
+                   std::int32_t const& tile_size = 64) -> void;
+}
+
+#endif  // IMAGEPP_TILE_HPP
@@ -0,0 +1,123 @@
+/**
+ * @file   tone.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Tone curves compiled into lookup tables
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "tone.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "parallel.hpp"
+#include "png.hpp"
+
+namespace nrv {
+auto compile_curve(curve_fn_t const& curve, std::int32_t const& size) -> lut1d {
+    return compile_curves({curve}, size);
+}
+
+auto compile_curves(std::vector<curve_fn_t> const& curves, std::int32_t const& size) -> lut1d {
+    if (curves.empty()) throw std::invalid_argument("nrv::compile_curves: needs at least one curve");
+    lut1d lut(size, static_cast<std::int32_t>(curves.size()));
+    auto const last = static_cast<float>(size - 1);
+    for (std::int32_t c = 0; c < lut.channels(); ++c) {
+        auto const& curve = curves[static_cast<std::size_t>(c)];
+        auto* table = lut.table(c);
+        for (std::int32_t i = 0; i < size; ++i) table[i] = curve(static_cast<float>(i) / last);
+    }
+    return lut;
+}
+
+auto gamma_curve(float const& gamma) -> curve_fn_t {
+    if (!(gamma > 0.0f)) throw std::invalid_argument("nrv::gamma_curve: gamma must be positive");
+    auto const exponent = 1.0f / gamma;
+    return [exponent](float const& value) { return std::pow(std::max(value, 0.0f), exponent); };
+}
+
+auto levels_curve(float const& black, float const& white, float const& gamma,
+                  float const& output_black, float const& output_white) -> curve_fn_t {
+    if (!(white > black)) throw std::invalid_argument("nrv::levels_curve: white point must exceed the black point");
+    if (!(gamma > 0.0f)) throw std::invalid_argument("nrv::levels_curve: gamma must be positive");
+    auto const exponent = 1.0f / gamma;
+    return [=](float const& value) {
+        auto const t = std::clamp((value - black) / (white - black), 0.0f, 1.0f);
+        return output_black + (output_white - output_black) * std::pow(t, exponent);
+    };
+}
+
+auto spline_curve(std::vector<glm::vec2> points) -> curve_fn_t {
+    if (points.size() < 2) throw std::invalid_argument("nrv::spline_curve: needs at least two points");
+    std::sort(points.begin(), points.end(), [](auto const& a, auto const& b) { return a.x < b.x; });
+    auto const count = points.size();
+    for (std::size_t i = 1; i < count; ++i)
+        if (!(points[i].x > points[i - 1].x)) throw std::invalid_argument("nrv::spline_curve: points must have distinct x");
+
+    // Secant slopes, then tangents limited so each segment stays monotone.
+    std::vector<float> secant(count - 1), tangent(count);
+    for (std::size_t i = 0; i + 1 < count; ++i)
+        secant[i] = (points[i + 1].y - points[i].y) / (points[i + 1].x - points[i].x);
+    tangent[0] = secant[0];
+    tangent[count - 1] = secant[count - 2];
+    for (std::size_t i = 1; i + 1 < count; ++i)
+        tangent[i] = secant[i - 1] * secant[i] <= 0.0f ? 0.0f : (secant[i - 1] + secant[i]) * 0.5f;
+    for (std::size_t i = 0; i + 1 < count; ++i) {
+        if (secant[i] == 0.0f) {
+            tangent[i] = tangent[i + 1] = 0.0f;
+            continue;
+        }
+        auto const a = tangent[i] / secant[i];
+        auto const b = tangent[i + 1] / secant[i];
+        auto const length = a * a + b * b;
+        if (length > 9.0f) {
+            auto const scale = 3.0f / std::sqrt(length);
+            tangent[i]     = scale * a * secant[i];
+            tangent[i + 1] = scale * b * secant[i];
+        }
+    }
+
+    return [points = std::move(points), tangent = std::move(tangent)](float const& value) {
+        if (value <= points.front().x) return points.front().y;
+        if (value >= points.back().x) return points.back().y;
+        auto const upper = static_cast<std::size_t>(std::upper_bound(points.begin(), points.end(), value,
+            [](float const& v, glm::vec2 const& p) { return v < p.x; }) - points.begin());
+        auto const i = upper - 1;
+        auto const h = points[upper].x - points[i].x;
+        auto const t = (value - points[i].x) / h;
+        auto const t2 = t * t, t3 = t2 * t;
+        return (2.0f * t3 - 3.0f * t2 + 1.0f) * points[i].y + (t3 - 2.0f * t2 + t) * h * tangent[i]
+             + (-2.0f * t3 + 3.0f * t2) * points[upper].y + (t3 - t2) * h * tangent[upper];
+    };
+}
+
+auto convert_u8(image const& source, std::uint8_t* destination, lut1d const& lut) -> void {
+    auto const channels = source.channels();
+    auto const colour   = colour_channels(channels);
+    if (lut.channels() != 1 && lut.channels() != colour)
+        throw std::invalid_argument("nrv::convert_u8: table must have 1 channel or one per colour channel");
+
+    auto const width = source.width();
+    parallel_for_range(source.height(), 16, [&](std::int32_t const& begin, std::int32_t const& end) {
+        for (auto y = begin; y < end; ++y) {
+            auto const offset = static_cast<std::size_t>(y) * static_cast<std::size_t>(width * channels);
+            auto const* in = source.buffer() + offset;
+            auto* out = destination + offset;
+            for (std::int32_t x = 0; x < width; ++x) {
+                for (std::int32_t c = 0; c < channels; ++c) {
+                    auto const value = c < colour ? lut(in[x * channels + c], lut.channels() == 1 ? 0 : c) : in[x * channels + c];
+                    out[x * channels + c] = static_cast<std::uint8_t>(std::clamp(value * 255.0f, 0.0f, 255.0f));
+                }
+            }
+        }
+    });
+}
+
+auto write_png(std::string const& filename, image const& img, lut1d const& lut) -> void {
+    std::vector<std::uint8_t> pixels(img.size());
+    convert_u8(img, pixels.data(), lut);
+    write_file(filename, encode_png(pixels.data(), img.width(), img.height(), img.channels()));
+}
+}
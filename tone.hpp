@@ -0,0 +1,66 @@
+/**
+ * @file   tone.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Tone curves compiled into lookup tables
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_TONE_HPP
+#define IMAGEPP_TONE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "image.hpp"
+#include "lut.hpp"
+
+namespace nrv {
+using curve_fn_t = std::function<float(float const& value)>;
+
+/**
+ * Sample a curve over [0, 1] into a table, the curve is evaluated once per entry so pow and friends
+ * leave the per pixel path. 4096 entries keep the interpolation error of smooth curves below 8-bit
+ * precision, 65536 entries suit steep curves and 16-bit output.
+ */
+auto compile_curve(curve_fn_t const& curve, std::int32_t const& size = 4096) -> lut1d;
+
+/**
+ * One curve per colour channel.
+ */
+auto compile_curves(std::vector<curve_fn_t> const& curves, std::int32_t const& size = 4096) -> lut1d;
+
+/**
+ * value^(1 / gamma), gamma above 1 brightens.
+ */
+auto gamma_curve(float const& gamma) -> curve_fn_t;
+
+/**
+ * Levels, input black and white points are stretched to the output range with a midtone gamma in between.
+ */
+auto levels_curve(float const& black, float const& white, float const& gamma = 1.0f,
+                  float const& output_black = 0.0f, float const& output_white = 1.0f) -> curve_fn_t;
+
+/**
+ * Monotone cubic through control points (Fritsch-Carlson), the curve never overshoots between points
+ * so increasing points give an increasing curve. Points outside [0, 1] are allowed, the ends are held flat.
+ */
+auto spline_curve(std::vector<glm::vec2> points) -> curve_fn_t;
+
+/**
+ * Apply a tone table and convert to 8-bit in one pass.
+ * @param source      Image to convert.
+ * @param destination width * height * channels bytes.
+ * @param lut         Table with one channel or one per colour channel, alpha is only converted.
+ */
+auto convert_u8(image const& source, std::uint8_t* destination, lut1d const& lut) -> void;
+
+/**
+ * Save as PNG with the tone table fused into the 8-bit conversion, for panel response compensation.
+ */
+auto write_png(std::string const& filename, image const& img, lut1d const& lut) -> void;
+}
+
+#endif  // IMAGEPP_TONE_HPP
@@ -0,0 +1,171 @@
+/**
+ * @file   warp.cpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Affine and projective image warps
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#include "warp.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include "parallel.hpp"
+
+namespace nrv {
+namespace {
+constexpr std::int32_t tile_size = 64;
+
+auto catmull_rom(float const& t) -> std::array<float, 4> {
+    auto const t2 = t * t;
+    auto const t3 = t2 * t;
+    return {
+        0.5f * (-t3 + 2.0f * t2 - t),
+        0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f),
+        0.5f * (-3.0f * t3 + 4.0f * t2 + t),
+        0.5f * (t3 - t2),
+    };
+}
+
+struct sampler_context {
+    image const& source;
+    std::int32_t channels;
+    std::array<float, 4> border;
+
+    auto texel(std::int32_t const& x, std::int32_t const& y) const -> float const* {
+        if (x < 0 || y < 0 || x >= source.width() || y >= source.height()) return border.data();
+        return source.buffer() + (static_cast<std::size_t>(y) * static_cast<std::size_t>(source.width())
+                                + static_cast<std::size_t>(x)) * static_cast<std::size_t>(channels);
+    }
+    auto inside(std::int32_t const& x0, std::int32_t const& y0, std::int32_t const& taps) const -> bool {
+        return x0 >= 0 && y0 >= 0 && x0 + taps <= source.width() && y0 + taps <= source.height();
+    }
+
+    auto nearest(float const& sx, float const& sy, float* out) const -> void {
+        auto const* p = texel(static_cast<std::int32_t>(std::floor(sx + 0.5f)), static_cast<std::int32_t>(std::floor(sy + 0.5f)));
+        std::copy_n(p, channels, out);
+    }
+
+    auto bilinear(float const& sx, float const& sy, float* out) const -> void {
+        auto const fx = std::floor(sx);
+        auto const fy = std::floor(sy);
+        auto const x0 = static_cast<std::int32_t>(fx);
+        auto const y0 = static_cast<std::int32_t>(fy);
+        auto const tx = sx - fx;
+        auto const ty = sy - fy;
+        float const* p[4];
+        if (inside(x0, y0, 2)) {
+            // Fast path, no per tap bounds checks.
+            p[0] = texel(x0, y0);
+            p[1] = p[0] + channels;
+            p[2] = p[0] + source.width() * channels;
+            p[3] = p[2] + channels;
+        } else {
+            p[0] = texel(x0, y0);
+            p[1] = texel(x0 + 1, y0);
+            p[2] = texel(x0, y0 + 1);
+            p[3] = texel(x0 + 1, y0 + 1);
+        }
+        for (std::int32_t c = 0; c < channels; ++c) {
+            auto const top    = p[0][c] + (p[1][c] - p[0][c]) * tx;
+            auto const bottom = p[2][c] + (p[3][c] - p[2][c]) * tx;
+            out[c] = top + (bottom - top) * ty;
+        }
+    }
+
+    auto bicubic(float const& sx, float const& sy, float* out) const -> void {
+        auto const fx = std::floor(sx);
+        auto const fy = std::floor(sy);
+        auto const x0 = static_cast<std::int32_t>(fx) - 1;
+        auto const y0 = static_cast<std::int32_t>(fy) - 1;
+        auto const wx = catmull_rom(sx - fx);
+        auto const wy = catmull_rom(sy - fy);
+        auto const fast = inside(x0, y0, 4);
+        std::fill_n(out, channels, 0.0f);
+        for (std::int32_t i = 0; i < 4; ++i) {
+            for (std::int32_t j = 0; j < 4; ++j) {
+                auto const* p = fast ? source.buffer() + (static_cast<std::size_t>(y0 + i) * static_cast<std::size_t>(source.width())
+                                                        + static_cast<std::size_t>(x0 + j)) * static_cast<std::size_t>(channels)
+                                     : texel(x0 + j, y0 + i);
+                auto const w = wx[static_cast<std::size_t>(j)] * wy[static_cast<std::size_t>(i)];
+                for (std::int32_t c = 0; c < channels; ++c) out[c] += w * p[c];
+            }
+        }
+    }
+};
+}
+
+auto warp(image const& source, image& destination, glm::mat3 const& transform, warp_sampler const& sampler, glm::vec4 const& border) -> void {
+    if (source.channels() != destination.channels() || source.channels() > 4)
+        throw std::invalid_argument("nrv::warp: source and destination channels differ or exceed 4");
+    if (source.buffer() == destination.buffer())
+        throw std::invalid_argument("nrv::warp: source and destination must be different images");
+    if (std::abs(glm::determinant(transform)) < 1e-12f)
+        throw std::invalid_argument("nrv::warp: transform is not invertible");
+
+    auto const inverse  = glm::inverse(transform);
+    auto const affine   = inverse[0][2] == 0.0f && inverse[1][2] == 0.0f && inverse[2][2] == 1.0f;
+    auto const channels = destination.channels();
+    auto const tiles_x  = (destination.width()  + tile_size - 1) / tile_size;
+    auto const tiles_y  = (destination.height() + tile_size - 1) / tile_size;
+    sampler_context const context{source, channels, {border.r, border.g, border.b, border.a}};
+    auto const max_x = static_cast<float>(source.width()) + 2.0f;
+    auto const max_y = static_cast<float>(source.height()) + 2.0f;
+
+    parallel_for(tiles_x * tiles_y, [&](std::int32_t const& index) {
+        auto const tx0 = (index % tiles_x) * tile_size;
+        auto const ty0 = (index / tiles_x) * tile_size;
+        auto const tx1 = std::min(tx0 + tile_size, destination.width());
+        auto const ty1 = std::min(ty0 + tile_size, destination.height());
+        auto const step = inverse[0];
+
+        for (auto y = ty0; y < ty1; ++y) {
+            // Source position of the first pixel in the row, then one add per pixel.
+            auto p = inverse * glm::vec3{static_cast<float>(tx0) + 0.5f, static_cast<float>(y) + 0.5f, 1.0f};
+            auto* out = destination.buffer() + (static_cast<std::size_t>(y) * static_cast<std::size_t>(destination.width())
+                                              + static_cast<std::size_t>(tx0)) * static_cast<std::size_t>(channels);
+            for (auto x = tx0; x < tx1; ++x, p += step, out += channels) {
+                if (!affine && p.z <= 0.0f) {
+                    std::copy_n(context.border.data(), channels, out);
+                    continue;
+                }
+                auto const w  = affine ? 1.0f : 1.0f / p.z;
+                auto const sx = p.x * w - 0.5f;
+                auto const sy = p.y * w - 0.5f;
+                // Every tap two pixels past the edge is border, and near the horizon the coordinates can grow
+                // beyond the integer range or become non-finite. The negated test also catches NaN.
+                if (!(sx > -2.0f && sx < max_x && sy > -2.0f && sy < max_y)) {
+                    std::copy_n(context.border.data(), channels, out);
+                    continue;
+                }
+                switch (sampler) {
+                    case warp_sampler::nearest:  context.nearest(sx, sy, out);  break;
+                    case warp_sampler::bilinear: context.bilinear(sx, sy, out); break;
+                    case warp_sampler::bicubic:  context.bicubic(sx, sy, out);  break;
+                }
+            }
+        }
+    });
+}
+
+auto rotate(image const& source, float const& angle, warp_sampler const& sampler, glm::vec4 const& border) -> image {
+    auto const c = std::cos(angle);
+    auto const s = std::sin(angle);
+    auto const w = static_cast<float>(source.width());
+    auto const h = static_cast<float>(source.height());
+    auto const width  = static_cast<std::int32_t>(std::ceil(std::abs(w * c) + std::abs(h * s) - 1e-3f));
+    auto const height = static_cast<std::int32_t>(std::ceil(std::abs(w * s) + std::abs(h * c) - 1e-3f));
+
+    // Image y points down, so a counter clockwise turn on screen is a negative angle in these coordinates.
+    glm::mat3 const to_origin{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, -w * 0.5f, -h * 0.5f, 1.0f};
+    glm::mat3 const turn{c, -s, 0.0f, s, c, 0.0f, 0.0f, 0.0f, 1.0f};
+    glm::mat3 const to_centre{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, static_cast<float>(width) * 0.5f, static_cast<float>(height) * 0.5f, 1.0f};
+
+    image output{std::max(width, 1), std::max(height, 1), source.channels()};
+    warp(source, output, to_centre * turn * to_origin, sampler, border);
+    return output;
+}
+}
@@ -0,0 +1,45 @@
+/**
+ * @file   warp.hpp
+ * @author mononerv (me@mononerv.dev)
+ * @brief  Affine and projective image warps
+ * @date   2026-10-18
+ *
+ * @copyright Copyright (c) 2026 mononerv
+ */
+#ifndef IMAGEPP_WARP_HPP
+#define IMAGEPP_WARP_HPP
+
+#include "glm/glm.hpp"
+
+#include "image.hpp"
+
+namespace nrv {
+enum class warp_sampler {
+    nearest,
+    bilinear,
+    bicubic,  // Catmull-Rom
+};
+
+/**
+ * Warp source into destination. The transform maps source coordinates to destination coordinates in
+ * pixel units with pixel centres at +0.5, every destination pixel is pulled through the inverse.
+ * The inverse is stepped incrementally along each row, a projective transform pays one divide per pixel.
+ * The output is walked in tiles on the worker pool so the source reads of a rotation stay local.
+ * @param source      Image to warp.
+ * @param destination Output, same channels as source, any size.
+ * @param transform   Source to destination mapping, affine when the last row is (0, 0, 1).
+ * @param sampler     Interpolation used to read the source.
+ * @param border      Colour for samples outside the source.
+ */
+auto warp(image const& source, image& destination, glm::mat3 const& transform,
+          warp_sampler const& sampler = warp_sampler::bilinear, glm::vec4 const& border = glm::vec4{0.0f}) -> void;
+
+/**
+ * Rotate around the centre, the output is sized to the bounding box of the rotated image.
+ * @param angle Counter clockwise angle in radians.
+ */
+auto rotate(image const& source, float const& angle,
+            warp_sampler const& sampler = warp_sampler::bilinear, glm::vec4 const& border = glm::vec4{0.0f}) -> image;
+}
+
+#endif  // IMAGEPP_WARP_HPP